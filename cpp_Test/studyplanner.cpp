@@ -1,21 +1,50 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <charconv>
+#include <cstring>
 #include <algorithm>
 #include <ctime>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <map>
+#include <set>
 #include <memory>
 #include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <cctype>
+#include <unordered_map>
+#include <queue>
+#include <limits>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <atomic>
+#include <chrono>
+#include <random>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
 // Forward declarations
 class Course;
 class TimeSlot;
-class StudySession;
+struct StudySession;
 class Schedule;
 
 // ==================== BASE CLASSES (ABSTRACTION) ====================
@@ -33,12 +62,91 @@ public:
     virtual void deserialize(const string& data) = 0;
 };
 
+// ==================== CALENDAR HELPERS ====================
+// Dates are handled as day numbers since 1970-01-01 (proleptic Gregorian),
+// so "how many days between" and "which weekday" are integer arithmetic.
+class Calendar {
+public:
+    static int daysFromCivil(int year, int month, int day) {
+        year -= month <= 2;
+        const int era = (year >= 0 ? year : year - 399) / 400;
+        const int yearOfEra = year - era * 400;
+        const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+    
+    static void civilFromDays(int days, int& year, int& month, int& day) {
+        days += 719468;
+        const int era = (days >= 0 ? days : days - 146096) / 146097;
+        const int dayOfEra = days - era * 146097;
+        const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const int mp = (5 * dayOfYear + 2) / 153;
+        day = dayOfYear - (153 * mp + 2) / 5 + 1;
+        month = mp < 10 ? mp + 3 : mp - 9;
+        year = yearOfEra + era * 400 + (month <= 2);
+    }
+    
+    // "YYYY-MM-DD" -> day number
+    static int parseIsoDate(string_view date) {
+        int year = 0, month = 0, day = 0;
+        if (date.size() != 10 || date[4] != '-' || date[7] != '-' ||
+            !readDigits(date.substr(0, 4), year) || !readDigits(date.substr(5, 2), month) ||
+            !readDigits(date.substr(8, 2), day) || month < 1 || month > 12 || day < 1 || day > 31) {
+            throw invalid_argument("Date must be YYYY-MM-DD, got: " + string(date));
+        }
+        int result = daysFromCivil(year, month, day);
+        int y, m, d;
+        civilFromDays(result, y, m, d);
+        if (m != month) {
+            throw invalid_argument("No such date: " + string(date));
+        }
+        return result;
+    }
+    
+    // All of 'text' as a non-negative decimal number
+    static bool readDigits(string_view text, int& value) {
+        if (text.empty() || !isdigit((unsigned char)text[0])) return false;
+        auto result = from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == errc() && result.ptr == text.data() + text.size();
+    }
+    
+    static string formatIsoDate(int days) {
+        int year, month, day;
+        civilFromDays(days, year, month, day);
+        stringstream ss;
+        ss << year << "-" << setfill('0') << setw(2) << month << "-" 
+           << setfill('0') << setw(2) << day;
+        return ss.str();
+    }
+    
+    // 0 = Monday ... 6 = Sunday (1970-01-01 was a Thursday)
+    static int weekday(int days) {
+        return ((days % 7) + 7 + 3) % 7;
+    }
+    
+    // Cached per second, since every priority update asks for it
+    static int today() {
+        static thread_local time_t cachedAt = -1;
+        static thread_local int cachedDay = 0;
+        time_t now = time(0);
+        if (now != cachedAt) {
+            tm* timeinfo = localtime(&now);
+            cachedDay = daysFromCivil(timeinfo->tm_year + 1900, timeinfo->tm_mon + 1, timeinfo->tm_mday);
+            cachedAt = now;
+        }
+        return cachedDay;
+    }
+};
+
 // ==================== COURSE CLASS (ENCAPSULATION) ====================
 class Course : public Schedulable, public Persistable {
 private:
     string name;
     int difficulty;           // 1-5 scale
     string examDate;         // YYYY-MM-DD format
+    int examDay;             // examDate as a Calendar day number
     int totalHoursNeeded;
     int hoursCompleted;
     double priority;
@@ -47,14 +155,16 @@ public:
     // Constructor
     Course(const string& courseName, int diff, const string& examDt, int totalHrs)
         : name(courseName), difficulty(diff), examDate(examDt), 
+          examDay(Calendar::parseIsoDate(examDt)),
           totalHoursNeeded(totalHrs), hoursCompleted(0), priority(0.0) {
         calculatePriority();
     }
     
     // Getters (Encapsulation)
-    string getName() const { return name; }
+    const string& getName() const { return name; }
     int getDifficulty() const { return difficulty; }
     string getExamDate() const { return examDate; }
+    int getExamDay() const { return examDay; }
     int getTotalHours() const { return totalHoursNeeded; }
     int getCompletedHours() const { return hoursCompleted; }
     int getRemainingHours() const { return totalHoursNeeded - hoursCompleted; }
@@ -68,63 +178,22 @@ public:
     }
     
     void addStudyHours(int hours) {
-        if (hoursCompleted + hours <= totalHoursNeeded) {
+        if (hours >= 0 && hoursCompleted + hours <= totalHoursNeeded) {
             hoursCompleted += hours;
             calculatePriority();
         }
     }
     
-    // FIXED: Calculate days until exam - corrected version
+    // Throws invalid_argument for a malformed date
+    void setExamDate(const string& examDt) {
+        examDay = Calendar::parseIsoDate(examDt);
+        examDate = examDt;
+        calculatePriority();
+    }
+    
+    // Whole calendar days from today to the exam (negative once it passed)
     int getDaysUntilExam() const {
-        // Get current date
-        time_t now = time(0);
-        tm* timeinfo = localtime(&now);
-        
-        // Parse exam date (YYYY-MM-DD)
-        int examYear = stoi(examDate.substr(0, 4));
-        int examMonth = stoi(examDate.substr(5, 2));
-        int examDay = stoi(examDate.substr(8, 2));
-        
-        // Get current date components
-        int currentDay = timeinfo->tm_mday;
-        int currentMonth = timeinfo->tm_mon + 1;  // tm_mon is 0-based
-        int currentYear = timeinfo->tm_year + 1900;
-        
-        // Create tm structures for both dates at midnight (normalize time)
-        tm examDate_tm = {};
-        examDate_tm.tm_year = examYear - 1900;    // tm_year is years since 1900
-        examDate_tm.tm_mon = examMonth - 1;       // tm_mon is 0-based (0 = January)
-        examDate_tm.tm_mday = examDay;
-        examDate_tm.tm_hour = 0;                  // Set to start of day
-        examDate_tm.tm_min = 0;
-        examDate_tm.tm_sec = 0;
-        examDate_tm.tm_isdst = -1;                // Let system determine DST
-        
-        tm currentDate_tm = {};
-        currentDate_tm.tm_year = currentYear - 1900;
-        currentDate_tm.tm_mon = currentMonth - 1;
-        currentDate_tm.tm_mday = currentDay;
-        currentDate_tm.tm_hour = 0;               // Set to start of day
-        currentDate_tm.tm_min = 0;
-        currentDate_tm.tm_sec = 0;
-        currentDate_tm.tm_isdst = -1;             // Let system determine DST
-        
-        // Convert to time_t for calculation
-        time_t examTime = mktime(&examDate_tm);
-        time_t currentTime = mktime(&currentDate_tm);
-        
-        // Handle invalid dates
-        if (examTime == -1 || currentTime == -1) {
-            return 30; // Fallback for invalid dates
-        }
-        
-        // Calculate difference in seconds, then convert to days
-        double secondsDiff = difftime(examTime, currentTime);
-        
-        // Round to nearest day instead of truncating
-        int daysDiff = (int)round(secondsDiff / (24.0 * 60.0 * 60.0));
-        
-        return daysDiff;
+        return examDay - Calendar::today();
     }
     
     // IMPROVED: Calculate priority with better handling of edge cases
@@ -192,222 +261,4881 @@ public:
         return ss.str();
     }
     
+    // Throws invalid_argument for a malformed record
     void deserialize(const string& data) override {
-        stringstream ss(data);
-        string token;
-        
-        getline(ss, name, ',');
-        getline(ss, token, ','); difficulty = stoi(token);
-        getline(ss, examDate, ',');
-        getline(ss, token, ','); totalHoursNeeded = stoi(token);
-        getline(ss, token, ','); hoursCompleted = stoi(token);
-        
-        calculatePriority();
+        string_view line(data);
+        string_view field[5];
+        size_t end = line.size();
+        for (int f = 4; f > 0; f--) {
+            size_t comma = end > 0 ? line.rfind(',', end - 1) : string_view::npos;
+            if (comma == string_view::npos) throw invalid_argument("Expected 5 comma-separated fields");
+            field[f] = line.substr(comma + 1, end - comma - 1);
+            end = comma;
+        }
+        field[0] = line.substr(0, end);
+        *this = *fromFields(field);
+    }
+    
+    // Build a course from the fields of a serialize() record: name,
+    // difficulty, exam date, total hours, hours completed. Throws
+    // invalid_argument naming the first bad field.
+    static shared_ptr<Course> fromFields(const string_view (&field)[5]) {
+        int diff, totalHrs, completedHrs;
+        if (field[0].empty()) throw invalid_argument("Course name is empty");
+        if (!Calendar::readDigits(field[1], diff) || diff < 1 || diff > 5) {
+            throw invalid_argument("Difficulty must be 1-5, got: " + string(field[1]));
+        }
+        if (!Calendar::readDigits(field[3], totalHrs) || totalHrs <= 0) {
+            throw invalid_argument("Total hours must be positive, got: " + string(field[3]));
+        }
+        if (!Calendar::readDigits(field[4], completedHrs) || completedHrs > totalHrs) {
+            throw invalid_argument("Hours completed must be 0-" + to_string(totalHrs) + 
+                                   ", got: " + string(field[4]));
+        }
+        auto course = make_shared<Course>(string(field[0]), diff, string(field[2]), totalHrs);
+        course->setHoursCompleted(completedHrs);
+        return course;
     }
 };
 
 // ==================== TIME SLOT CLASS ====================
+// A weekly interval stored as minute offsets from Monday 00:00. The
+// strings typed by the user are parsed and validated once, so duration,
+// overlap and ordering checks are plain integer math.
 class TimeSlot {
 private:
-    string day;
-    string startTime;
-    string endTime;
+    uint16_t startMinute;    // 0 .. MINUTES_PER_WEEK
+    uint16_t endMinute;
     bool available;
     
+    static const char* const* dayNames() {
+        static const char* const names[] = {
+            "Monday", "Tuesday", "Wednesday", "Thursday",
+            "Friday", "Saturday", "Sunday"
+        };
+        return names;
+    }
+    
 public:
+    static constexpr int MINUTES_PER_DAY = 24 * 60;
+    static constexpr int MINUTES_PER_WEEK = 7 * MINUTES_PER_DAY;
+    
+    // "monday", "Monday", "MONDAY" -> 0 ... "Sunday" -> 6
+    static int parseDay(const string& dayName) {
+        string lower;
+        for (char c : dayName) lower += (char)tolower((unsigned char)c);
+        for (int i = 0; i < 7; i++) {
+            string candidate = dayNames()[i];
+            candidate[0] = (char)tolower((unsigned char)candidate[0]);
+            if (lower == candidate) return i;
+        }
+        throw invalid_argument("Unknown day: " + dayName);
+    }
+    
+    // "HH:MM" -> minutes since midnight; "24:00" is accepted as end of day
+    static int parseClock(string_view clock) {
+        if (clock.size() != 5 || clock[2] != ':' ||
+            !isdigit((unsigned char)clock[0]) || !isdigit((unsigned char)clock[1]) ||
+            !isdigit((unsigned char)clock[3]) || !isdigit((unsigned char)clock[4])) {
+            throw invalid_argument("Time must be HH:MM, got: " + string(clock));
+        }
+        int hours = (clock[0] - '0') * 10 + (clock[1] - '0');
+        int minutes = (clock[3] - '0') * 10 + (clock[4] - '0');
+        if (minutes > 59 || hours > 24 || (hours == 24 && minutes != 0)) {
+            throw invalid_argument("Time out of range: " + string(clock));
+        }
+        return hours * 60 + minutes;
+    }
+    
+    static string formatClock(int minuteOfDay) {
+        stringstream ss;
+        ss << setfill('0') << setw(2) << minuteOfDay / 60 << ":"
+           << setfill('0') << setw(2) << minuteOfDay % 60;
+        return ss.str();
+    }
+    
+    static string dayName(int dayIndex) { return dayNames()[dayIndex]; }
+    
     TimeSlot(const string& d, const string& start, const string& end)
-        : day(d), startTime(start), endTime(end), available(true) {}
+        : available(true) {
+        int dayOffset = parseDay(d) * MINUTES_PER_DAY;
+        int startOfDay = parseClock(start);
+        int endOfDay = parseClock(end);
+        if (endOfDay <= startOfDay) {
+            throw invalid_argument("End time must be after start time: " + start + "-" + end);
+        }
+        startMinute = (uint16_t)(dayOffset + startOfDay);
+        endMinute = (uint16_t)(dayOffset + endOfDay);
+    }
+    
+    // Build directly from week offsets (already validated by the caller)
+    TimeSlot(int startOffset, int endOffset)
+        : startMinute((uint16_t)startOffset), endMinute((uint16_t)endOffset), 
+          available(true) {}
     
     // Getters
-    string getDay() const { return day; }
-    string getStartTime() const { return startTime; }
-    string getEndTime() const { return endTime; }
+    int getDayIndex() const { return startMinute / MINUTES_PER_DAY; }
+    string getDay() const { return dayName(getDayIndex()); }
+    string getStartTime() const { return formatClock(startMinute - getDayIndex() * MINUTES_PER_DAY); }
+    string getEndTime() const { return formatClock(endMinute - getDayIndex() * MINUTES_PER_DAY); }
+    int getStartMinute() const { return startMinute; }
+    int getEndMinute() const { return endMinute; }
     bool isAvailable() const { return available; }
     
     void setAvailable(bool avail) { available = avail; }
     
-    // Calculate duration in hours
-    int getDurationHours() const {
-        // Simplified - parse HH:MM format
-        int startHour = stoi(startTime.substr(0, 2));
-        int endHour = stoi(endTime.substr(0, 2));
-        return endHour - startHour;
+    int getDurationMinutes() const { return endMinute - startMinute; }
+    double getDurationHours() const { return getDurationMinutes() / 60.0; }
+    
+    // Half-open intervals: touching slots (09:00-10:00, 10:00-11:00) don't overlap
+    bool overlaps(const TimeSlot& other) const {
+        return (startMinute < other.endMinute) & (other.startMinute < endMinute);
+    }
+    
+    bool operator<(const TimeSlot& other) const {
+        // Pack (start, end) into one integer so ordering is a single compare
+        return (((uint32_t)startMinute << 16) | endMinute) <
+               (((uint32_t)other.startMinute << 16) | other.endMinute);
+    }
+    
+    void displayInfo() const {
+        cout << getDay() << " " << getStartTime() << "-" << getEndTime() 
+             << " (" << formatHours(getDurationMinutes()) << "h) " 
+             << (available ? "Available" : "Booked") << endl;
+    }
+    
+    // "3" for whole hours, "1.5" / "0.25" otherwise
+    static string formatHours(int minutes) {
+        stringstream ss;
+        if (minutes % 60 == 0) ss << minutes / 60;
+        else ss << defaultfloat << setprecision(4) << minutes / 60.0;
+        return ss.str();
+    }
+};
+
+// ==================== AVAILABILITY BITMAP ====================
+// One bit per 15-minute quarter of the week (672 bits), padded to twelve
+// 64-bit words so the set operations run as whole 128-bit SIMD lanes.
+// Overlapping and adjacent slots simply merge into the same bits, and
+// capacity questions become popcounts over a handful of words.
+class AvailabilityBitmap {
+public:
+    static constexpr int QUARTER_MINUTES = 15;
+    static constexpr int QUARTERS = TimeSlot::MINUTES_PER_WEEK / QUARTER_MINUTES;
+    static constexpr int QUARTERS_PER_DAY = TimeSlot::MINUTES_PER_DAY / QUARTER_MINUTES;
+    static constexpr int WORDS = 12;
+    
+private:
+    alignas(16) uint64_t words[WORDS];
+    
+    static int popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(x);
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+    
+    static int countTrailingZeros64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+#else
+        int n = 0;
+        while (!(x & 1)) { x >>= 1; n++; }
+        return n;
+#endif
+    }
+    
+    // Bits [bit, bit + span) of one word, span in 1..64
+    static uint64_t spanMask(int bit, int span) {
+        return (span == 64 ? ~0ULL : ((1ULL << span) - 1)) << bit;
+    }
+    
+    void assignQuarters(int first, int last, bool value) {
+        while (first < last) {
+            int bit = first & 63;
+            int span = min(64 - bit, last - first);
+            uint64_t mask = spanMask(bit, span);
+            if (value) words[first >> 6] |= mask;
+            else words[first >> 6] &= ~mask;
+            first += span;
+        }
+    }
+    
+    // First quarter >= from whose bit equals 'value', or QUARTERS
+    int nextWithValue(int from, bool value) const {
+        if (from >= QUARTERS) return QUARTERS;
+        uint64_t flip = value ? 0 : ~0ULL;
+        int w = from >> 6;
+        uint64_t word = (words[w] ^ flip) & (~0ULL << (from & 63));
+        while (word == 0) {
+            if (++w == WORDS) return QUARTERS;
+            word = words[w] ^ flip;
+        }
+        return min(QUARTERS, (w << 6) + countTrailingZeros64(word));
+    }
+    
+public:
+    AvailabilityBitmap() { clear(); }
+    
+    void clear() {
+        for (int i = 0; i < WORDS; i++) words[i] = 0;
+    }
+    
+    // Only whole quarters inside the slot count as free: 09:10-10:00
+    // contributes 09:15-10:00
+    static int firstQuarter(const TimeSlot& slot) {
+        return (slot.getStartMinute() + QUARTER_MINUTES - 1) / QUARTER_MINUTES;
+    }
+    static int lastQuarter(const TimeSlot& slot) {
+        return slot.getEndMinute() / QUARTER_MINUTES;
+    }
+    
+    void addSlot(const TimeSlot& slot) {
+        assignQuarters(firstQuarter(slot), lastQuarter(slot), true);
+    }
+    
+    void removeSlot(const TimeSlot& slot) {
+        assignQuarters(slot.getStartMinute() / QUARTER_MINUTES,
+                       (slot.getEndMinute() + QUARTER_MINUTES - 1) / QUARTER_MINUTES, false);
+    }
+    
+    bool test(int quarter) const {
+        return (words[quarter >> 6] >> (quarter & 63)) & 1;
+    }
+    
+    // ---- Set algebra (SSE2 when available, plain word loop otherwise) ----
+    AvailabilityBitmap& operator|=(const AvailabilityBitmap& other) {
+#if defined(__SSE2__)
+        for (int i = 0; i < WORDS; i += 2) {
+            __m128i a = _mm_load_si128((const __m128i*)(words + i));
+            __m128i b = _mm_load_si128((const __m128i*)(other.words + i));
+            _mm_store_si128((__m128i*)(words + i), _mm_or_si128(a, b));
+        }
+#else
+        for (int i = 0; i < WORDS; i++) words[i] |= other.words[i];
+#endif
+        return *this;
+    }
+    
+    AvailabilityBitmap& operator&=(const AvailabilityBitmap& other) {
+#if defined(__SSE2__)
+        for (int i = 0; i < WORDS; i += 2) {
+            __m128i a = _mm_load_si128((const __m128i*)(words + i));
+            __m128i b = _mm_load_si128((const __m128i*)(other.words + i));
+            _mm_store_si128((__m128i*)(words + i), _mm_and_si128(a, b));
+        }
+#else
+        for (int i = 0; i < WORDS; i++) words[i] &= other.words[i];
+#endif
+        return *this;
+    }
+    
+    // Remove every quarter that is set in 'other' (e.g. booked time)
+    AvailabilityBitmap& subtract(const AvailabilityBitmap& other) {
+#if defined(__SSE2__)
+        for (int i = 0; i < WORDS; i += 2) {
+            __m128i a = _mm_load_si128((const __m128i*)(words + i));
+            __m128i b = _mm_load_si128((const __m128i*)(other.words + i));
+            _mm_store_si128((__m128i*)(words + i), _mm_andnot_si128(b, a));
+        }
+#else
+        for (int i = 0; i < WORDS; i++) words[i] &= ~other.words[i];
+#endif
+        return *this;
+    }
+    
+    friend AvailabilityBitmap operator|(AvailabilityBitmap a, const AvailabilityBitmap& b) { return a |= b; }
+    friend AvailabilityBitmap operator&(AvailabilityBitmap a, const AvailabilityBitmap& b) { return a &= b; }
+    
+    bool isEmpty() const {
+        uint64_t any = 0;
+        for (int i = 0; i < WORDS; i++) any |= words[i];
+        return any == 0;
+    }
+    
+    bool intersects(const AvailabilityBitmap& other) const {
+        uint64_t any = 0;
+        for (int i = 0; i < WORDS; i++) any |= words[i] & other.words[i];
+        return any != 0;
+    }
+    
+    bool intersects(const TimeSlot& slot) const {
+        return countQuarters(slot.getStartMinute() / QUARTER_MINUTES,
+                             (slot.getEndMinute() + QUARTER_MINUTES - 1) / QUARTER_MINUTES) > 0;
+    }
+    
+    // ---- Capacity ----
+    int countQuarters(int first = 0, int last = QUARTERS) const {
+        int total = 0;
+        while (first < last) {
+            int bit = first & 63;
+            int span = min(64 - bit, last - first);
+            total += popcount64(words[first >> 6] & spanMask(bit, span));
+            first += span;
+        }
+        return total;
+    }
+    
+    int freeMinutes() const { return countQuarters() * QUARTER_MINUTES; }
+    
+    // Free minutes strictly before the start of the given weekday (0 = Monday)
+    int freeMinutesBeforeDay(int dayIndex) const {
+        return countQuarters(0, dayIndex * QUARTERS_PER_DAY) * QUARTER_MINUTES;
+    }
+    
+    // ---- Run search ----
+    // Start quarter of the first free run of at least minQuarters beginning
+    // at or after 'from', or -1
+    int findFreeRun(int minQuarters, int from = 0) const {
+        int quarter = from;
+        while (quarter < QUARTERS) {
+            int start = nextWithValue(quarter, true);
+            if (start >= QUARTERS) return -1;
+            int end = nextWithValue(start, false);
+            if (end - start >= minQuarters) return start;
+            quarter = end;
+        }
+        return -1;
+    }
+    
+    // Calls fn(firstQuarter, lastQuarter) for each maximal free run
+    template <typename Fn>
+    void forEachRun(Fn fn) const {
+        int quarter = 0;
+        while (quarter < QUARTERS) {
+            int start = nextWithValue(quarter, true);
+            if (start >= QUARTERS) return;
+            int end = nextWithValue(start, false);
+            fn(start, end);
+            quarter = end;
+        }
+    }
+    
+    // Overlapping and adjacent slots come back merged, split at midnight
+    vector<TimeSlot> toSlots() const {
+        vector<TimeSlot> slots;
+        forEachRun([&](int first, int last) {
+            while (first < last) {
+                int dayEnd = (first / QUARTERS_PER_DAY + 1) * QUARTERS_PER_DAY;
+                int end = min(last, dayEnd);
+                slots.emplace_back(first * QUARTER_MINUTES, end * QUARTER_MINUTES);
+                first = end;
+            }
+        });
+        return slots;
+    }
+};
+
+// ==================== SLOT INDEX ====================
+// The weekly slots as disjoint intervals of minutes since Monday 00:00,
+// kept in a balanced tree keyed by start. Inserting merges every interval
+// the new one overlaps or touches (never across midnight, so each merged
+// interval is still a single-day slot): O(log n) plus the intervals that
+// get absorbed. "Free at T" is one upper_bound; "slots in a range" is a
+// lookup plus the k intervals returned.
+class SlotIndex {
+private:
+    map<int, int> intervals;    // start -> end, disjoint and non-touching within a day
+    
+    static TimeSlot toSlot(const pair<const int, int>& interval) {
+        return TimeSlot(interval.first, interval.second);
+    }
+    
+    // First interval that ends after 'minute' (may start after it)
+    map<int, int>::const_iterator firstEndingAfter(int minute) const {
+        auto it = intervals.upper_bound(minute);
+        if (it != intervals.begin()) {
+            auto before = prev(it);
+            if (before->second > minute) return before;
+        }
+        return it;
+    }
+    
+public:
+    // Add a slot; returns how many existing slots it was merged with
+    int insert(const TimeSlot& slot) {
+        int start = slot.getStartMinute(), end = slot.getEndMinute();
+        if (end <= start) return 0;
+        int dayStart = start / TimeSlot::MINUTES_PER_DAY * TimeSlot::MINUTES_PER_DAY;
+        int dayEnd = dayStart + TimeSlot::MINUTES_PER_DAY;
+        
+        // Neighbours on the same day that overlap or touch [start, end)
+        auto it = intervals.upper_bound(start);
+        if (it != intervals.begin() && prev(it)->second >= start && prev(it)->first >= dayStart) --it;
+        int merged = 0;
+        while (it != intervals.end() && it->first <= end && it->first < dayEnd) {
+            start = min(start, it->first);
+            end = max(end, it->second);
+            it = intervals.erase(it);
+            merged++;
+        }
+        intervals.emplace_hint(it, start, end);
+        return merged;
+    }
+    
+    // Take [start, end) out of whatever slots cover it
+    void erase(const TimeSlot& slot) {
+        int start = slot.getStartMinute(), end = slot.getEndMinute();
+        auto it = firstEndingAfter(start);
+        while (it != intervals.end() && it->first < end) {
+            int first = it->first, last = it->second;
+            it = intervals.erase(it);
+            if (first < start) intervals.emplace(first, start);
+            if (last > end) it = intervals.emplace(end, last).first;
+        }
+    }
+    
+    // Remove the n-th slot in week order (as listed); O(n) walk to it
+    bool eraseAt(size_t position, TimeSlot& removed) {
+        if (position >= intervals.size()) return false;
+        auto it = next(intervals.begin(), position);
+        removed = toSlot(*it);
+        intervals.erase(it);
+        return true;
+    }
+    
+    size_t size() const { return intervals.size(); }
+    bool empty() const { return intervals.empty(); }
+    void clear() { intervals.clear(); }
+    
+    // Does 'slot' share any time with the indexed slots?
+    bool overlaps(const TimeSlot& slot) const {
+        auto it = firstEndingAfter(slot.getStartMinute());
+        return it != intervals.end() && it->first < slot.getEndMinute();
+    }
+    
+    // The slot containing 'minuteOfWeek', if any
+    bool freeAt(int minuteOfWeek, TimeSlot& found) const {
+        auto it = firstEndingAfter(minuteOfWeek);
+        if (it == intervals.end() || it->first > minuteOfWeek) return false;
+        found = toSlot(*it);
+        return true;
+    }
+    
+    bool isFreeAt(int minuteOfWeek) const {
+        auto it = firstEndingAfter(minuteOfWeek);
+        return it != intervals.end() && it->first <= minuteOfWeek;
+    }
+    
+    // Slots sharing time with [fromMinute, toMinute), clipped to the range
+    vector<TimeSlot> slotsInRange(int fromMinute, int toMinute) const {
+        vector<TimeSlot> found;
+        for (auto it = firstEndingAfter(fromMinute); it != intervals.end() && it->first < toMinute; ++it) {
+            found.emplace_back(max(it->first, fromMinute), min(it->second, toMinute));
+        }
+        return found;
+    }
+    
+    // All slots in week order
+    vector<TimeSlot> toVector() const {
+        vector<TimeSlot> slots;
+        slots.reserve(intervals.size());
+        for (const auto& interval : intervals) slots.push_back(toSlot(interval));
+        return slots;
+    }
+};
+
+// ==================== GROUP STUDY ====================
+// Common free time of several students. Each student's week is one
+// AvailabilityBitmap, so the intersection of N students is N passes of a
+// twelve-word SIMD AND (stopping early once nothing is left) and the
+// windows fall out of the run scan: a 100-student group costs a few
+// thousand word operations, independent of how many slots each entered.
+class GroupStudyFinder {
+public:
+    static AvailabilityBitmap toBitmap(const vector<TimeSlot>& slots) {
+        AvailabilityBitmap bitmap;
+        for (const auto& slot : slots) {
+            if (slot.isAvailable()) bitmap.addSlot(slot);
+        }
+        return bitmap;
+    }
+    
+    // Time every student is free (empty for an empty group)
+    static AvailabilityBitmap commonTime(const vector<AvailabilityBitmap>& students) {
+        if (students.empty()) return AvailabilityBitmap();
+        AvailabilityBitmap common = students[0];
+        for (size_t i = 1; i < students.size() && !common.isEmpty(); i++) common &= students[i];
+        return common;
+    }
+    
+    // Windows of at least 'minMinutes' in which everyone is free, in week
+    // order and split at midnight
+    static vector<TimeSlot> commonWindows(const vector<AvailabilityBitmap>& students, int minMinutes) {
+        const int quarter = AvailabilityBitmap::QUARTER_MINUTES;
+        int minQuarters = max(1, (minMinutes + quarter - 1) / quarter);
+        
+        vector<TimeSlot> windows;
+        commonTime(students).forEachRun([&](int first, int last) {
+            while (first < last) {
+                int dayEnd = (first / AvailabilityBitmap::QUARTERS_PER_DAY + 1) * AvailabilityBitmap::QUARTERS_PER_DAY;
+                int end = min(last, dayEnd);
+                if (end - first >= minQuarters) windows.emplace_back(first * quarter, end * quarter);
+                first = end;
+            }
+        });
+        return windows;
+    }
+    
+    static vector<TimeSlot> commonWindows(const vector<vector<TimeSlot>>& students, int minMinutes) {
+        vector<AvailabilityBitmap> bitmaps;
+        bitmaps.reserve(students.size());
+        for (const auto& slots : students) bitmaps.push_back(toBitmap(slots));
+        return commonWindows(bitmaps, minMinutes);
+    }
+};
+
+// ==================== STUDY SESSION CLASS ====================
+// One booked block as a 12-byte record with no pointers or strings, so a
+// schedule is a flat array that copies with memcpy and scans at memory
+// speed. The course is an index into the owning Schedule's course table
+// (Schedule::getCourse turns it back into the course).
+struct StudySession {
+    uint32_t course;        // index into the schedule's course table
+    int32_t date;           // Calendar day number of this occurrence
+    uint16_t startMinute;   // minutes since midnight
+    uint16_t minutes;
+    
+    int getDate() const { return date; }
+    int getStartMinute() const { return startMinute; }
+    int getDurationMinutes() const { return minutes; }
+    double getDurationHours() const { return minutes / 60.0; }
+    
+    // The booked interval as a weekly TimeSlot
+    TimeSlot getTimeSlot() const {
+        int dayOffset = Calendar::weekday(date) * TimeSlot::MINUTES_PER_DAY;
+        return TimeSlot(dayOffset + startMinute, dayOffset + startMinute + minutes);
+    }
+};
+
+// ==================== SCHEDULE CLASS ====================
+// Result of the capacity pre-check: cumulative demand of all courses whose
+// exams fall on or before each exam date vs. slot time available before it
+struct CapacityCheck {
+    struct ExamShortfall {
+        int examDay;                // Calendar day number
+        long long demandMinutes;    // all courses examined up to this day
+        long long capacityMinutes;  // slot time before this day
+        long long shortfallMinutes() const { return demandMinutes - capacityMinutes; }
+    };
+    
+    vector<ExamShortfall> shortfalls;   // only exams that can't be met
+    long long totalDemandMinutes;
+    long long totalCapacityMinutes;
+    
+    CapacityCheck() : totalDemandMinutes(0), totalCapacityMinutes(0) {}
+    
+    bool isFeasible() const { return shortfalls.empty(); }
+    // Nothing at all can be placed before any exam
+    bool isHopeless() const { return totalCapacityMinutes == 0 && totalDemandMinutes > 0; }
+    
+    void display() const {
+        if (isFeasible()) {
+            cout << "Capacity check: OK (" << TimeSlot::formatHours((int)totalDemandMinutes) 
+                 << "h needed, " << TimeSlot::formatHours((int)totalCapacityMinutes) 
+                 << "h available)" << endl;
+            return;
+        }
+        cout << "Capacity check: not enough study time before these exams:" << endl;
+        for (const auto& entry : shortfalls) {
+            cout << "  " << Calendar::formatIsoDate(entry.examDay) << ": need "
+                 << TimeSlot::formatHours((int)entry.demandMinutes) << "h, have "
+                 << TimeSlot::formatHours((int)entry.capacityMinutes) << "h (short "
+                 << TimeSlot::formatHours((int)entry.shortfallMinutes()) << "h)" << endl;
+        }
+    }
+};
+
+// Per-course outcome of one allocation run
+struct CourseFeasibility {
+    string courseName;
+    int examDay;              // Calendar day number
+    int requiredMinutes;
+    int scheduledMinutes;
+    
+    bool isFeasible() const { return scheduledMinutes >= requiredMinutes; }
+    int shortfallMinutes() const { return max(0, requiredMinutes - scheduledMinutes); }
+};
+
+// Courses by name for loading saved schedules. Keys view the names the
+// courses own, so building the index copies no strings.
+class CourseNameIndex {
+private:
+    unordered_map<string_view, shared_ptr<Course>> byName;
+    
+public:
+    CourseNameIndex() = default;
+    explicit CourseNameIndex(const vector<shared_ptr<Course>>& courses) {
+        byName.reserve(courses.size());
+        for (const auto& course : courses) byName.emplace(course->getName(), course);
+    }
+    
+    // nullptr if no course has this name
+    const shared_ptr<Course>* find(string_view name) const {
+        auto it = byName.find(name);
+        return it != byName.end() ? &it->second : nullptr;
+    }
+};
+
+class Schedule : public Persistable {
+private:
+    vector<StudySession> sessions;
+    // Interned courses: each course is stored once, sessions refer to it
+    // by position
+    vector<shared_ptr<Course>> courseTable;
+    unordered_map<const Course*, uint32_t> courseIds;
+    // Running totals, kept in step with 'sessions' on every add and remove
+    long long totalMinutes;
+    vector<long long> courseMinutes;          // by course-table position
+    unordered_map<int, long long> dayMinutes; // by Calendar day number
+    vector<CourseFeasibility> feasibility;
+    string scheduleName;
+    long long bookedSlotMinutes;
+    long long totalSlotMinutes;
+    
+    uint32_t internCourse(const shared_ptr<Course>& course) {
+        auto inserted = courseIds.emplace(course.get(), (uint32_t)courseTable.size());
+        if (inserted.second) {
+            courseTable.push_back(course);
+            courseMinutes.push_back(0);
+        }
+        return inserted.first->second;
+    }
+    
+    // Where a load is within the serialize() layout
+    struct LoadState {
+        const CourseNameIndex* courses;
+        size_t line = 0;
+        size_t expectedSessions = 0;
+    };
+    
+    // Header lines are the name and the session count; every later line is
+    // "course,date,day,start,end,hours". Fields are split from the right so
+    // course names may contain commas. The weekday and hours must agree
+    // with the date and times.
+    void loadLine(string_view line, LoadState& state) {
+        state.line++;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (state.line == 1) {
+            scheduleName = string(line);
+            return;
+        }
+        if (state.line == 2) {
+            auto result = from_chars(line.data(), line.data() + line.size(), state.expectedSessions);
+            if (result.ec != errc() || result.ptr != line.data() + line.size()) {
+                throw invalid_argument("Line 2: expected the session count, got: " + string(line));
+            }
+            return;
+        }
+        if (line.empty()) return;
+        
+        string_view field[6];
+        size_t end = line.size();
+        for (int f = 5; f > 0; f--) {
+            size_t comma = end > 0 ? line.rfind(',', end - 1) : string_view::npos;
+            if (comma == string_view::npos) {
+                throw invalid_argument("Line " + to_string(state.line) + ": expected 6 fields");
+            }
+            field[f] = line.substr(comma + 1, end - comma - 1);
+            end = comma;
+        }
+        field[0] = line.substr(0, end);
+        
+        const shared_ptr<Course>* course = state.courses->find(field[0]);
+        if (!course) {
+            throw invalid_argument("Line " + to_string(state.line) + ": unknown course: " + string(field[0]));
+        }
+        try {
+            int day = Calendar::parseIsoDate(field[1]);
+            int start = TimeSlot::parseClock(field[3]);
+            int finish = TimeSlot::parseClock(field[4]);
+            if (finish <= start) throw invalid_argument("End time must be after start time");
+            if (TimeSlot::parseDay(string(field[2])) != Calendar::weekday(day)) {
+                throw invalid_argument(string(field[1]) + " is not a " + string(field[2]));
+            }
+            // Written with four significant digits (TimeSlot::formatHours)
+            double hours = 0;
+            auto parsed = from_chars(field[5].data(), field[5].data() + field[5].size(), hours);
+            int minutes = finish - start;
+            if (parsed.ec != errc() || parsed.ptr != field[5].data() + field[5].size() ||
+                fabs(hours * 60 - minutes) > max(0.5, minutes * 0.0005)) {
+                throw invalid_argument("Hours " + string(field[5]) + " don't match " + 
+                                       string(field[3]) + "-" + string(field[4]));
+            }
+            addSession(*course, day, start, minutes);
+        } catch (const invalid_argument& e) {
+            throw invalid_argument("Line " + to_string(state.line) + ": " + e.what());
+        }
+    }
+    
+    void finishLoad(const LoadState& state) const {
+        if (state.line < 2) throw invalid_argument("Schedule file is missing its header");
+        if (sessions.size() != state.expectedSessions) {
+            throw invalid_argument("Expected " + to_string(state.expectedSessions) + 
+                                   " sessions, read " + to_string(sessions.size()));
+        }
+    }
+    
+    void count(const StudySession& session, int sign) {
+        totalMinutes += sign * session.minutes;
+        courseMinutes[session.course] += sign * session.minutes;
+        auto day = dayMinutes.find(session.date);
+        if (day == dayMinutes.end()) day = dayMinutes.emplace(session.date, 0).first;
+        if ((day->second += sign * session.minutes) == 0) dayMinutes.erase(day);
+    }
+    
+public:
+    Schedule(const string& name) 
+        : totalMinutes(0), scheduleName(name), bookedSlotMinutes(0), totalSlotMinutes(0) {}
+    
+    // 'startMinute' is minutes since midnight of 'day'
+    void addSession(const shared_ptr<Course>& course, int day, int startMinute, int minutes) {
+        sessions.push_back(StudySession{internCourse(course), day, (uint16_t)startMinute, (uint16_t)minutes});
+        count(sessions.back(), 1);
+    }
+    
+    // Remove the session at 'index', keeping the others in order
+    void removeSession(size_t index) {
+        if (index >= sessions.size()) return;
+        count(sessions[index], -1);
+        sessions.erase(sessions.begin() + index);
+    }
+    
+    // Copy a session of another schedule
+    void addSession(const Schedule& other, const StudySession& session) {
+        addSession(other.getCourse(session), session.date, session.startMinute, session.minutes);
+    }
+    
+    void reserve(size_t count) { sessions.reserve(count); }
+    
+    const vector<StudySession>& getSessions() const { return sessions; }
+    const shared_ptr<Course>& getCourse(const StudySession& session) const { return courseTable[session.course]; }
+    const vector<shared_ptr<Course>>& getCourseTable() const { return courseTable; }
+    
+    // Position of each course-table entry in 'courses', or -1, so a scan
+    // can index by StudySession::course instead of hashing pointers
+    vector<int> positionsIn(const vector<shared_ptr<Course>>& courses) const {
+        vector<int> position(courseTable.size(), -1);
+        for (size_t i = 0; i < courses.size(); i++) {
+            auto it = courseIds.find(courses[i].get());
+            if (it != courseIds.end()) position[it->second] = (int)i;
+        }
+        return position;
+    }
+    
+    void displaySession(const StudySession& session) const {
+        TimeSlot slot = session.getTimeSlot();
+        cout << "Study Session: " << getCourse(session)->getName() << endl;
+        cout << "Time: " << Calendar::formatIsoDate(session.date) << " " << slot.getDay() << " " 
+             << slot.getStartTime() << "-" << slot.getEndTime() << endl;
+        cout << "Duration: " << TimeSlot::formatHours(session.minutes) << " hours" << endl;
+    }
+    
+    // How much of the offered slot time the sessions use
+    void setUtilization(long long bookedMinutes, long long totalMinutes) {
+        bookedSlotMinutes = bookedMinutes;
+        totalSlotMinutes = totalMinutes;
+    }
+    
+    double getUtilization() const {
+        return totalSlotMinutes > 0 ? (double)bookedSlotMinutes / totalSlotMinutes : 0.0;
+    }
+    
+    void setFeasibilityReport(const vector<CourseFeasibility>& report) {
+        feasibility = report;
+    }
+    
+    const vector<CourseFeasibility>& getFeasibilityReport() const { return feasibility; }
+    
+    void displayFeasibility() const {
+        if (feasibility.empty()) return;
+        
+        cout << "\nCourse Feasibility:" << endl;
+        cout << left << setw(24) << "Course" << setw(12) << "Exam" 
+             << setw(10) << "Needed" << setw(11) << "Scheduled" << "Status" << endl;
+        for (const auto& entry : feasibility) {
+            cout << left << setw(24) << entry.courseName 
+                 << setw(12) << Calendar::formatIsoDate(entry.examDay)
+                 << setw(10) << TimeSlot::formatHours(entry.requiredMinutes) + "h"
+                 << setw(11) << TimeSlot::formatHours(entry.scheduledMinutes) + "h";
+            if (entry.isFeasible()) {
+                cout << "OK";
+            } else {
+                cout << "SHORT " << TimeSlot::formatHours(entry.shortfallMinutes()) << "h";
+            }
+            cout << right << endl;
+        }
+    }
+    
+    void displaySchedule() const {
+        cout << "\n=== " << scheduleName << " ===" << endl;
+        cout << "Total Sessions: " << sessions.size() << endl;
+        if (totalSlotMinutes > 0) {
+            cout << "Slot Utilization: " << fixed << setprecision(1) 
+                 << getUtilization() * 100 << "% (" 
+                 << TimeSlot::formatHours((int)bookedSlotMinutes) << " of "
+                 << TimeSlot::formatHours((int)totalSlotMinutes) << " hours)" << endl;
+        }
+        displayFeasibility();
+        
+        if (sessions.empty()) {
+            cout << "No study sessions scheduled." << endl;
+            cout << "This could mean:" << endl;
+            cout << "- All courses are complete" << endl;
+            cout << "- No available time slots" << endl;
+            cout << "- All exam dates have passed" << endl;
+            return;
+        }
+        
+        cout << "\nDetailed Schedule:" << endl;
+        cout << string(50, '-') << endl;
+        
+        for (const auto& session : sessions) {
+            displaySession(session);
+            cout << string(30, '-') << endl;
+        }
+    }
+    
+    double getTotalStudyHours() const { return totalMinutes / 60.0; }
+    long long getTotalStudyMinutes() const { return totalMinutes; }
+    
+    // Minutes booked for 'course' / on Calendar day 'day', O(1)
+    long long getCourseMinutes(const Course* course) const {
+        auto it = courseIds.find(course);
+        return it != courseIds.end() ? courseMinutes[it->second] : 0;
+    }
+    
+    long long getDayMinutes(int day) const {
+        auto it = dayMinutes.find(day);
+        return it != dayMinutes.end() ? it->second : 0;
+    }
+    
+    size_t getStudyDayCount() const { return dayMinutes.size(); }
+    
+    // Serialization
+    string serialize() const override {
+        stringstream ss;
+        ss << scheduleName << "\n";
+        ss << sessions.size() << "\n";
+        for (const auto& session : sessions) {
+            TimeSlot slot = session.getTimeSlot();
+            ss << getCourse(session)->getName() << ","
+               << Calendar::formatIsoDate(session.getDate()) << ","
+               << slot.getDay() << ","
+               << slot.getStartTime() << ","
+               << slot.getEndTime() << ","
+               << TimeSlot::formatHours(session.getDurationMinutes()) << "\n";
+        }
+        return ss.str();
+    }
+    
+    // Persistable form: course names resolve only against the courses this
+    // schedule already refers to, so it can re-read its own sessions but a
+    // new Schedule accepts no sessions. Pass the course list to load anything else.
+    void deserialize(const string& data) override {
+        deserialize(data, CourseNameIndex(courseTable));
+    }
+    
+    // Read serialize() output in one pass, replacing this schedule's
+    // sessions. Throws invalid_argument naming the first bad line.
+    void deserialize(const string& data, const CourseNameIndex& courses) {
+        Schedule loaded("");
+        LoadState state{&courses};
+        string_view rest(data);
+        while (!rest.empty()) {
+            size_t newline = rest.find('\n');
+            loaded.loadLine(rest.substr(0, newline), state);
+            rest.remove_prefix(newline == string_view::npos ? rest.size() : newline + 1);
+        }
+        loaded.finishLoad(state);
+        *this = move(loaded);
+    }
+    
+    // Stream serialize() output from 'in' in fixed-size chunks, so memory
+    // beyond the loaded sessions is bounded by the longest line, not the
+    // file. Throws invalid_argument naming the first bad line.
+    void load(istream& in, const CourseNameIndex& courses) {
+        static constexpr size_t CHUNK = 1 << 16;
+        Schedule loaded("");
+        LoadState state{&courses};
+        vector<char> buffer(CHUNK);
+        size_t kept = 0;     // bytes of an unfinished line at the front
+        while (true) {
+            if (kept == buffer.size()) buffer.resize(buffer.size() * 2);
+            in.read(buffer.data() + kept, buffer.size() - kept);
+            size_t filled = kept + (size_t)in.gcount();
+            bool atEnd = filled == kept;
+            
+            const char* begin = buffer.data();
+            const char* limit = buffer.data() + filled;
+            while (const char* newline = (const char*)memchr(begin, '\n', limit - begin)) {
+                loaded.loadLine(string_view(begin, newline - begin), state);
+                begin = newline + 1;
+            }
+            kept = limit - begin;
+            if (atEnd) {
+                if (kept > 0) loaded.loadLine(string_view(begin, kept), state);
+                break;
+            }
+            memmove(buffer.data(), begin, kept);
+        }
+        loaded.finishLoad(state);
+        *this = move(loaded);
+    }
+};
+
+// ==================== SLOT HORIZON (RECURRING SLOTS) ====================
+// One dated occurrence of a weekly slot
+struct SlotOccurrence {
+    uint32_t id;            // chronological position within the horizon
+    uint32_t slotIndex;     // index into the weekly slot list
+    int day;                // Calendar day number
+    uint16_t startMinute;   // minutes since midnight
+    uint16_t endMinute;
+    
+    int getDurationMinutes() const { return endMinute - startMinute; }
+};
+
+// The weekly slots repeated over [startDay, endDay). Nothing is
+// materialized: occurrence k of the horizon is computed on demand from
+// (week, slot) arithmetic, so a year-long horizon costs the same memory as
+// a single week.
+class SlotHorizon {
+private:
+    vector<TimeSlot> weekly;            // usable slots, ordered by week offset
+    vector<uint32_t> originalIndex;     // weekly[i] -> index in the caller's list
+    int slotsBeforeWeekday[8];          // prefix count of slots per weekday
+    long long minutesBeforeWeekday[8];  // prefix capacity per weekday
+    long long minutesPerWeek;
+    int firstMonday;                    // Monday of the week containing startDay
+    int startDay;
+    int endDay;
+    uint32_t firstIndex;                // occurrences before startDay (skipped)
+    uint32_t occurrenceCount;
+    
+    // Occurrences from firstMonday up to (not including) 'day'
+    long long countBefore(int day) const {
+        if (day <= firstMonday) return 0;
+        long long offset = day - firstMonday;
+        long long weeks = offset / 7;
+        return weeks * (long long)weekly.size() + slotsBeforeWeekday[offset % 7];
+    }
+    
+public:
+    SlotHorizon(const vector<TimeSlot>& slots, int fromDay, int toDay)
+        : minutesPerWeek(0), startDay(fromDay), endDay(max(fromDay, toDay)) {
+        for (uint32_t i = 0; i < slots.size(); i++) {
+            if (slots[i].isAvailable() && slots[i].getDurationMinutes() > 0) {
+                originalIndex.push_back(i);
+            }
+        }
+        sort(originalIndex.begin(), originalIndex.end(), [&](uint32_t a, uint32_t b) {
+            return slots[a] < slots[b];
+        });
+        for (uint32_t i : originalIndex) weekly.push_back(slots[i]);
+        
+        for (int d = 0; d <= 7; d++) {
+            slotsBeforeWeekday[d] = 0;
+            minutesBeforeWeekday[d] = 0;
+        }
+        for (const auto& slot : weekly) {
+            for (int d = slot.getDayIndex() + 1; d <= 7; d++) {
+                slotsBeforeWeekday[d]++;
+                minutesBeforeWeekday[d] += slot.getDurationMinutes();
+            }
+            minutesPerWeek += slot.getDurationMinutes();
+        }
+        
+        firstMonday = startDay - Calendar::weekday(startDay);
+        firstIndex = (uint32_t)countBefore(startDay);
+        occurrenceCount = (uint32_t)(countBefore(endDay) - firstIndex);
+    }
+    
+    size_t size() const { return occurrenceCount; }
+    bool empty() const { return occurrenceCount == 0; }
+    int getStartDay() const { return startDay; }
+    int getEndDay() const { return endDay; }
+    const TimeSlot& weeklySlot(size_t i) const { return weekly[i]; }
+    size_t weeklySlotCount() const { return weekly.size(); }
+    
+    // O(1) - occurrence by chronological id
+    SlotOccurrence at(uint32_t id) const {
+        uint32_t k = id + firstIndex;
+        uint32_t week = k / (uint32_t)weekly.size();
+        uint32_t slot = k % (uint32_t)weekly.size();
+        const TimeSlot& t = weekly[slot];
+        int dayOffset = t.getDayIndex() * TimeSlot::MINUTES_PER_DAY;
+        SlotOccurrence occ;
+        occ.id = id;
+        occ.slotIndex = originalIndex[slot];
+        occ.day = firstMonday + (int)week * 7 + t.getDayIndex();
+        occ.startMinute = (uint16_t)(t.getStartMinute() - dayOffset);
+        occ.endMinute = (uint16_t)(t.getEndMinute() - dayOffset);
+        return occ;
+    }
+    
+    // O(1) - id of the first occurrence on or after 'day' (size() if none)
+    uint32_t firstOnOrAfter(int day) const {
+        day = min(max(day, startDay), endDay);
+        return (uint32_t)(countBefore(day) - firstIndex);
+    }
+    
+    // O(1) - slot minutes available on days [startDay, day)
+    long long capacityBefore(int day) const {
+        day = min(max(day, startDay), endDay);
+        auto minutesUpTo = [&](int d) -> long long {
+            if (d <= firstMonday) return 0;
+            long long offset = d - firstMonday;
+            return (offset / 7) * minutesPerWeek + minutesBeforeWeekday[offset % 7];
+        };
+        return minutesUpTo(day) - minutesUpTo(startDay);
+    }
+    
+    // Find the occurrence on 'day' that contains 'minuteOfDay'
+    bool locate(int day, int minuteOfDay, SlotOccurrence& found) const {
+        for (uint32_t id = firstOnOrAfter(day); id < occurrenceCount; id++) {
+            SlotOccurrence occ = at(id);
+            if (occ.day != day) break;
+            if (occ.startMinute <= minuteOfDay && minuteOfDay < occ.endMinute) {
+                found = occ;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Lazy forward iteration in date order
+    class iterator {
+    private:
+        const SlotHorizon* horizon;
+        uint32_t id;
+    public:
+        iterator(const SlotHorizon* h, uint32_t i) : horizon(h), id(i) {}
+        SlotOccurrence operator*() const { return horizon->at(id); }
+        iterator& operator++() { ++id; return *this; }
+        bool operator!=(const iterator& other) const { return id != other.id; }
+    };
+    
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, occurrenceCount); }
+};
+
+// ==================== STUDY LIMITS ====================
+// Optional caps on daily study time and the gap kept between sessions
+struct StudyLimits {
+    int maxMinutesPerDay;         // all courses together, 0 = no cap
+    int maxCourseMinutesPerDay;   // any single course, 0 = no cap
+    int minBreakMinutes;          // gap between two sessions in one slot
+    
+    StudyLimits() : maxMinutesPerDay(0), maxCourseMinutesPerDay(0), minBreakMinutes(0) {}
+    
+    bool isUnlimited() const {
+        return maxMinutesPerDay <= 0 && maxCourseMinutesPerDay <= 0 && minBreakMinutes <= 0;
+    }
+    
+    // Upper bound on study time over 'days' days with 'slotMinutes' of slots
+    long long capCapacity(long long slotMinutes, int days) const {
+        if (maxMinutesPerDay <= 0) return slotMinutes;
+        return min(slotMinutes, (long long)max(0, days) * maxMinutesPerDay);
+    }
+    
+    void display() const {
+        if (isUnlimited()) {
+            cout << "Study limits: none" << endl;
+            return;
+        }
+        cout << "Study limits:";
+        if (maxMinutesPerDay > 0) cout << " " << TimeSlot::formatHours(maxMinutesPerDay) << "h/day";
+        if (maxCourseMinutesPerDay > 0) {
+            cout << " " << TimeSlot::formatHours(maxCourseMinutesPerDay) << "h/day per course";
+        }
+        if (minBreakMinutes > 0) cout << " " << minBreakMinutes << " min breaks";
+        cout << endl;
+    }
+};
+
+// Running per-day totals for one allocation run. Days are indexed from the
+// first planned day and (course, day) cells are hashed, so checking or
+// recording a placement is O(1) however many sessions a day already has.
+class DailyLoad {
+private:
+    StudyLimits limits;
+    int firstDay;
+    vector<int> dayMinutes;
+    unordered_map<uint64_t, int> courseDayMinutes;
+    
+    static uint64_t cell(uint32_t course, int day) {
+        return ((uint64_t)course << 32) | (uint32_t)day;
+    }
+    
+public:
+    DailyLoad(const StudyLimits& l, int fromDay) : limits(l), firstDay(fromDay) {}
+    
+    const StudyLimits& getLimits() const { return limits; }
+    
+    // Most minutes any course may still add on 'day'
+    int dayAllowance(int day) const {
+        if (limits.maxMinutesPerDay <= 0) return numeric_limits<int>::max();
+        int index = day - firstDay;
+        int used = index >= 0 && index < (int)dayMinutes.size() ? dayMinutes[index] : 0;
+        return max(0, limits.maxMinutesPerDay - used);
+    }
+    
+    // Most minutes 'course' may still add on 'day'
+    int allowance(uint32_t course, int day) const {
+        int allowed = dayAllowance(day);
+        if (limits.maxCourseMinutesPerDay > 0) {
+            auto it = courseDayMinutes.find(cell(course, day));
+            int used = it == courseDayMinutes.end() ? 0 : it->second;
+            allowed = min(allowed, max(0, limits.maxCourseMinutesPerDay - used));
+        }
+        return allowed;
+    }
+    
+    // Record a placement; negative minutes give time back
+    void add(uint32_t course, int day, int minutes) {
+        if (limits.maxMinutesPerDay > 0 && day >= firstDay) {
+            size_t index = day - firstDay;
+            if (index >= dayMinutes.size()) dayMinutes.resize(index + 1, 0);
+            dayMinutes[index] += minutes;
+        }
+        if (limits.maxCourseMinutesPerDay > 0) {
+            courseDayMinutes[cell(course, day)] += minutes;
+        }
+    }
+};
+
+// ==================== SLOT ALLOCATOR ====================
+// Tracks the unbooked minutes of every slot occurrence as a small free
+// list, so one slot can hold several sessions (possibly for different
+// courses) instead of being thrown away after its first booking. Only
+// occurrences that have been touched get a free list; the rest of the
+// horizon is implicitly free. Study limits are checked per candidate
+// block in O(1): the daily counters bound its length and the break is
+// trimmed off any edge that borders booked time.
+class SlotAllocator {
+public:
+    enum FitPolicy {
+        FIRST_FIT,         // earliest block that holds the whole request
+        BEST_FIT,          // tightest block that holds the whole request
+        FIRST_AVAILABLE    // earliest usable block, even if it holds only part
+    };
+    
+    struct FreeBlock {
+        uint16_t start;
+        uint16_t end;
+        int length() const { return end - start; }
+    };
+    
+    // Result of a successful allocation
+    struct Booking {
+        SlotOccurrence occurrence;
+        int startMinute;        // minutes since midnight
+        int minutes;
+        
+        // The booked interval expressed as a weekly TimeSlot
+        TimeSlot toTimeSlot() const {
+            int dayOffset = Calendar::weekday(occurrence.day) * TimeSlot::MINUTES_PER_DAY;
+            return TimeSlot(dayOffset + startMinute, dayOffset + startMinute + minutes);
+        }
+    };
+    
+private:
+    const SlotHorizon& horizon;
+    unordered_map<uint32_t, vector<FreeBlock>> touched;   // occurrence id -> free blocks
+    vector<bool> blockedSlots;                            // weekly slot index -> withdrawn
+    FitPolicy policy;
+    int minSessionMinutes;
+    long long bookedMinutes;
+    DailyLoad load;
+    
+    const vector<FreeBlock>& freeBlocks(const SlotOccurrence& occ, vector<FreeBlock>& scratch) const {
+        auto it = touched.find(occ.id);
+        if (it != touched.end()) return it->second;
+        scratch.assign(1, FreeBlock{occ.startMinute, occ.endMinute});
+        return scratch;
+    }
+    
+    vector<FreeBlock>& touch(const SlotOccurrence& occ) {
+        auto inserted = touched.emplace(occ.id, vector<FreeBlock>());
+        if (inserted.second) inserted.first->second.push_back({occ.startMinute, occ.endMinute});
+        return inserted.first->second;
+    }
+    
+    bool isBlocked(const SlotOccurrence& occ) const {
+        return occ.slotIndex < blockedSlots.size() && blockedSlots[occ.slotIndex];
+    }
+    
+    // The part of a free block that keeps the minimum break. Free blocks
+    // are maximal, so an edge inside the slot always borders a session.
+    FreeBlock usable(const SlotOccurrence& occ, const FreeBlock& block) const {
+        int gap = load.getLimits().minBreakMinutes;
+        if (gap <= 0) return block;
+        int start = block.start + (block.start > occ.startMinute ? gap : 0);
+        int end = block.end - (block.end < occ.endMinute ? gap : 0);
+        return FreeBlock{(uint16_t)start, (uint16_t)max(start, end)};
+    }
+    
+public:
+    SlotAllocator(const SlotHorizon& h, FitPolicy fit, const StudyLimits& limits = StudyLimits(),
+                  int minSession = 30)
+        : horizon(h), policy(fit), minSessionMinutes(minSession), bookedMinutes(0),
+          load(limits, h.getStartDay()) {}
+    
+    // Book up to 'wanted' minutes of 'course' in an occurrence with
+    // beginId <= id < endId. If no block holds the whole request the
+    // largest usable block is taken instead (FIRST_AVAILABLE takes the
+    // earliest), so long courses still get scheduled; blocks shorter than
+    // the minimum session are ignored.
+    // Returns false when nothing usable is left.
+    bool allocate(int wanted, uint32_t endId, Booking& booking, uint32_t course = 0,
+                  uint32_t beginId = 0) {
+        int need = max(wanted, 1);
+        SlotOccurrence bestOcc = {};
+        size_t bestBlock = 0;
+        int bestLength = -1;
+        bool bestFits = false;
+        vector<FreeBlock> scratch;
+        
+        endId = min(endId, (uint32_t)horizon.size());
+        bool settled = false;
+        for (uint32_t id = beginId; id < endId && !settled; id++) {
+            SlotOccurrence occ = horizon.at(id);
+            if (isBlocked(occ)) continue;
+            int allowance = load.allowance(course, occ.day);
+            if (allowance < min(need, minSessionMinutes)) continue;
+            
+            const auto& blocks = freeBlocks(occ, scratch);
+            for (size_t b = 0; b < blocks.size(); b++) {
+                int length = min(usable(occ, blocks[b]).length(), allowance);
+                if (length < min(need, minSessionMinutes)) continue;
+                
+                bool fits = length >= need;
+                bool better;
+                if (bestLength < 0) better = true;
+                else if (fits != bestFits) better = fits;
+                else if (fits) better = policy == BEST_FIT && length < bestLength;
+                else better = length > bestLength;
+                
+                if (better) {
+                    bestOcc = occ;
+                    bestBlock = b;
+                    bestLength = length;
+                    bestFits = fits;
+                    if ((fits && policy == FIRST_FIT) || policy == FIRST_AVAILABLE) {
+                        settled = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (bestLength < 0) return false;
+        
+        booking.occurrence = bestOcc;
+        booking.startMinute = usable(bestOcc, touch(bestOcc)[bestBlock]).start;
+        booking.minutes = min(need, bestLength);
+        return book(bestOcc, booking.startMinute, booking.minutes, course);
+    }
+    
+    // Mark [startMinute, startMinute + minutes) of an occurrence as booked
+    // for 'course' (also used to load an existing schedule, which is taken
+    // as is even if it breaks the limits). Returns false if not free.
+    bool book(const SlotOccurrence& occ, int startMinute, int minutes, uint32_t course = 0) {
+        vector<FreeBlock>& blocks = touch(occ);
+        int end = startMinute + minutes;
+        for (size_t b = 0; b < blocks.size(); b++) {
+            FreeBlock block = blocks[b];
+            if (block.start > startMinute || block.end < end) continue;
+            blocks.erase(blocks.begin() + b);
+            if (end < block.end) blocks.insert(blocks.begin() + b, FreeBlock{(uint16_t)end, block.end});
+            if (block.start < startMinute) blocks.insert(blocks.begin() + b, FreeBlock{block.start, (uint16_t)startMinute});
+            bookedMinutes += minutes;
+            load.add(course, occ.day, minutes);
+            return true;
+        }
+        return false;
+    }
+    
+    // Give booked time back, merging it with neighbouring free blocks
+    void release(const SlotOccurrence& occ, int startMinute, int minutes, uint32_t course = 0) {
+        vector<FreeBlock>& blocks = touch(occ);
+        FreeBlock freed = {(uint16_t)startMinute, (uint16_t)(startMinute + minutes)};
+        auto at = lower_bound(blocks.begin(), blocks.end(), freed, 
+                              [](const FreeBlock& a, const FreeBlock& b) { return a.start < b.start; });
+        at = blocks.insert(at, freed);
+        if (at + 1 != blocks.end() && at->end == (at + 1)->start) {
+            at->end = (at + 1)->end;
+            blocks.erase(at + 1);
+        }
+        if (at != blocks.begin() && (at - 1)->end == at->start) {
+            (at - 1)->end = at->end;
+            blocks.erase(at);
+        }
+        bookedMinutes -= minutes;
+        load.add(course, occ.day, -minutes);
+    }
+    
+    // Withdraw a weekly slot: none of its occurrences are handed out again
+    void blockSlot(uint32_t slotIndex) {
+        if (slotIndex >= blockedSlots.size()) blockedSlots.resize(slotIndex + 1, false);
+        blockedSlots[slotIndex] = true;
+    }
+    
+    // First occurrence that still has a usable block of a minimum session
+    // on a day below its cap (per-course caps are not checked), or the
+    // horizon size if none is left. O(S).
+    uint32_t firstRoom() const {
+        if (getTotalMinutes() - bookedMinutes < minSessionMinutes) return (uint32_t)horizon.size();
+        vector<FreeBlock> scratch;
+        for (uint32_t id = 0; id < horizon.size(); id++) {
+            SlotOccurrence occ = horizon.at(id);
+            if (isBlocked(occ) || load.dayAllowance(occ.day) < minSessionMinutes) continue;
+            for (const auto& block : freeBlocks(occ, scratch)) {
+                if (usable(occ, block).length() >= minSessionMinutes) return id;
+            }
+        }
+        return (uint32_t)horizon.size();
+    }
+    
+    long long getTotalMinutes() const { return horizon.capacityBefore(horizon.getEndDay()); }
+    long long getBookedMinutes() const { return bookedMinutes; }
+    
+    double utilization() const {
+        long long total = getTotalMinutes();
+        return total > 0 ? (double)bookedMinutes / total : 0.0;
+    }
+};
+
+// ==================== FREE CAPACITY TREE ====================
+// Max segment tree over the occurrences of a horizon, keyed by occurrence
+// id (which is chronological), holding the free minutes left at the end of
+// each occurrence. Sessions are packed from the start of an occurrence, so
+// one number per occurrence describes its free space. "First occurrence at
+// or after day X with room for N minutes" and its mirror image are
+// answered in O(log S) without walking the calendar. Once an occurrence
+// holds a session, its free minutes exclude the break the next one needs.
+class FreeCapacityTree {
+private:
+    const SlotHorizon& horizon;
+    int breakMinutes;
+    size_t leaves;                  // power of two >= horizon size
+    vector<int> best;               // max free minutes per subtree
+    vector<uint16_t> cursor;        // first unbooked minute per occurrence
+    
+    int firstIn(size_t node, size_t left, size_t right, size_t lo, size_t hi, int need) const {
+        if (right <= lo || left >= hi || best[node] < need) return -1;
+        if (right - left == 1) return (int)left;
+        size_t mid = (left + right) / 2;
+        int found = firstIn(2 * node, left, mid, lo, hi, need);
+        return found >= 0 ? found : firstIn(2 * node + 1, mid, right, lo, hi, need);
+    }
+    
+    int lastIn(size_t node, size_t left, size_t right, size_t lo, size_t hi, int need) const {
+        if (right <= lo || left >= hi || best[node] < need) return -1;
+        if (right - left == 1) return (int)left;
+        size_t mid = (left + right) / 2;
+        int found = lastIn(2 * node + 1, mid, right, lo, hi, need);
+        return found >= 0 ? found : lastIn(2 * node, left, mid, lo, hi, need);
+    }
+    
+    int maxIn(size_t node, size_t left, size_t right, size_t lo, size_t hi) const {
+        if (right <= lo || left >= hi) return 0;
+        if (lo <= left && right <= hi) return best[node];
+        size_t mid = (left + right) / 2;
+        return max(maxIn(2 * node, left, mid, lo, hi), maxIn(2 * node + 1, mid, right, lo, hi));
+    }
+    
+public:
+    explicit FreeCapacityTree(const SlotHorizon& h, int minBreakMinutes = 0) 
+        : horizon(h), breakMinutes(max(0, minBreakMinutes)), leaves(1) {
+        while (leaves < horizon.size()) leaves *= 2;
+        best.assign(2 * leaves, 0);
+        cursor.resize(horizon.size());
+        for (uint32_t id = 0; id < horizon.size(); id++) {
+            SlotOccurrence occ = horizon.at(id);
+            cursor[id] = occ.startMinute;
+            best[leaves + id] = occ.getDurationMinutes();
+        }
+        for (size_t node = leaves - 1; node >= 1; node--) {
+            best[node] = max(best[2 * node], best[2 * node + 1]);
+        }
+    }
+    
+    // Earliest occurrence in [fromId, toId) with at least 'minutes' free,
+    // -1 if there is none
+    int firstFit(uint32_t fromId, uint32_t toId, int minutes) const {
+        return firstIn(1, 0, leaves, fromId, toId, minutes);
+    }
+    
+    // Latest occurrence in [fromId, toId) with at least 'minutes' free
+    int lastFit(uint32_t fromId, uint32_t toId, int minutes) const {
+        return lastIn(1, 0, leaves, fromId, toId, minutes);
+    }
+    
+    // Largest free run of any occurrence in [fromId, toId)
+    int maxFree(uint32_t fromId, uint32_t toId) const {
+        return maxIn(1, 0, leaves, fromId, toId);
+    }
+    
+    // Book 'minutes' at the front of the free part of occurrence 'id' and
+    // return the start minute
+    int take(uint32_t id, int minutes) {
+        SlotOccurrence occ = horizon.at(id);
+        int start = cursor[id] > occ.startMinute ? cursor[id] + breakMinutes : cursor[id];
+        cursor[id] = (uint16_t)(start + minutes);
+        size_t node = leaves + id;
+        best[node] = max(0, occ.endMinute - cursor[id] - breakMinutes);
+        for (node /= 2; node >= 1; node /= 2) {
+            best[node] = max(best[2 * node], best[2 * node + 1]);
+        }
+        return start;
+    }
+};
+
+// ==================== SCHEDULE OBJECTIVES ====================
+// Common yardstick for comparing schedules produced by different
+// strategies. Each component is normalized to 0..1, higher is better.
+struct ScheduleObjectives {
+    double coverage;    // scheduled / required study time
+    double balance;     // 1 - spread of daily load (as a share of each day's slot time)
+    double earliness;   // average buffer between a course's last session and its exam
+    
+    ScheduleObjectives() : coverage(0), balance(0), earliness(0) {}
+    
+    double combined() const {
+        return 0.6 * coverage + 0.25 * balance + 0.15 * earliness;
+    }
+    
+    static ScheduleObjectives evaluate(const Schedule& schedule,
+                                       const vector<shared_ptr<Course>>& activeCourses,
+                                       const SlotHorizon& horizon) {
+        ScheduleObjectives result;
+        const auto& sessions = schedule.getSessions();
+        
+        long long required = 0, scheduled = 0;
+        const int NONE = numeric_limits<int>::min();
+        vector<int> lastSessionDay(schedule.getCourseTable().size(), NONE);
+        map<int, long long> minutesByDay;
+        for (const auto& session : sessions) {
+            scheduled += session.getDurationMinutes();
+            minutesByDay[session.getDate()] += session.getDurationMinutes();
+            lastSessionDay[session.course] = max(lastSessionDay[session.course], session.getDate());
+        }
+        for (const auto& course : activeCourses) {
+            required += course->getRemainingHours() * 60;
+        }
+        result.coverage = required > 0 ? min(1.0, (double)scheduled / required) : 1.0;
+        
+        // Load per study day relative to that day's slot time, from the
+        // first day up to the last day anything is scheduled
+        if (!minutesByDay.empty()) {
+            int lastDay = minutesByDay.rbegin()->first;
+            double sum = 0, sumSquares = 0;
+            int days = 0;
+            for (int day = horizon.getStartDay(); day <= lastDay; day++) {
+                long long capacity = horizon.capacityBefore(day + 1) - horizon.capacityBefore(day);
+                if (capacity == 0) continue;
+                auto it = minutesByDay.find(day);
+                double load = it == minutesByDay.end() ? 0.0 : (double)it->second / capacity;
+                sum += load;
+                sumSquares += load * load;
+                days++;
+            }
+            double mean = days > 0 ? sum / days : 0.0;
+            double variance = days > 0 ? max(0.0, sumSquares / days - mean * mean) : 0.0;
+            result.balance = max(0.0, 1.0 - 2.0 * sqrt(variance));
+        }
+        
+        double earliness = 0;
+        vector<int> position = schedule.positionsIn(activeCourses);
+        for (size_t id = 0; id < position.size(); id++) {
+            if (position[id] < 0 || lastSessionDay[id] == NONE) continue;
+            const auto& course = activeCourses[position[id]];
+            int window = max(1, course->getExamDay() - horizon.getStartDay());
+            earliness += min(1.0, (double)(course->getExamDay() - lastSessionDay[id]) / window);
+        }
+        result.earliness = activeCourses.empty() ? 0.0 : earliness / activeCourses.size();
+        return result;
+    }
+};
+
+// ==================== THREAD POOL ====================
+// Fixed set of worker threads fed from one task queue. submit() returns a
+// future, so callers can fan work out and collect the results in order.
+// A pool task that submits more work must collect it with wait(), never
+// future::get(): get() would hold the worker while it blocks, and once every
+// worker is blocked the queued subtasks never run.
+class ThreadPool {
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex queueMutex;
+    condition_variable wakeUp;
+    bool stopping;
+    
+    // Run one queued task on the calling thread; false if none is queued
+    bool runPending() {
+        function<void()> task;
+        {
+            lock_guard<mutex> lock(queueMutex);
+            if (tasks.empty()) return false;
+            task = move(tasks.front());
+            tasks.pop();
+        }
+        task();
+        return true;
+    }
+    
+public:
+    explicit ThreadPool(size_t threadCount) : stopping(false) {
+        threadCount = max<size_t>(1, threadCount);
+        for (size_t i = 0; i < threadCount; i++) {
+            workers.emplace_back([this] {
+                while (true) {
+                    function<void()> task;
+                    {
+                        unique_lock<mutex> lock(queueMutex);
+                        wakeUp.wait(lock, [this] { return stopping || !tasks.empty(); });
+                        if (stopping && tasks.empty()) return;
+                        task = move(tasks.front());
+                        tasks.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+    
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    template <typename Fn>
+    auto submit(Fn fn) -> future<decltype(fn())> {
+        auto task = make_shared<packaged_task<decltype(fn())()>>(move(fn));
+        auto result = task->get_future();
+        {
+            lock_guard<mutex> lock(queueMutex);
+            tasks.push([task] { (*task)(); });
+        }
+        wakeUp.notify_one();
+        return result;
+    }
+    
+    // Block until 'result' is ready, running queued tasks on this thread
+    // meanwhile. Pool tasks must wait on work they submitted only this way.
+    template <typename T>
+    T wait(future<T>& result) {
+        while (result.wait_for(chrono::seconds(0)) != future_status::ready) {
+            if (!runPending()) result.wait_for(chrono::microseconds(200));
+        }
+        return result.get();
+    }
+    
+    size_t size() const { return workers.size(); }
+    
+    // Process-wide pool sized to the machine, created on first use
+    static ThreadPool& shared() {
+        static ThreadPool pool(max(2u, thread::hardware_concurrency()));
+        return pool;
+    }
+};
+
+// ==================== COMPLETION RISK ====================
+struct RiskOptions {
+    uint64_t seed;
+    int trials;
+    double missProbability;      // a session is skipped entirely
+    double overrunProbability;   // a session gets through less than planned...
+    double overrunFraction;      // ...because it needed up to this much more time
+    
+    RiskOptions() 
+        : seed(42), trials(10000), missProbability(0.15), overrunProbability(0.25), overrunFraction(0.5) {}
+};
+
+struct CourseRisk {
+    string courseName;
+    int examDay;                  // Calendar day number
+    int requiredMinutes;
+    int plannedMinutes;
+    double completionProbability;
+    double expectedMinutes;       // mean study time actually achieved
+};
+
+struct RiskReport {
+    vector<CourseRisk> courses;
+    RiskOptions options;
+    double milliseconds;
+    
+    void display() const {
+        cout << "\n=== Completion Risk ===" << endl;
+        cout << options.trials << " simulated runs, seed " << options.seed << ", "
+             << fixed << setprecision(0) << options.missProbability * 100 << "% of sessions missed, "
+             << options.overrunProbability * 100 << "% overrun" << endl;
+        cout << left << setw(24) << "Course" << setw(12) << "Exam" << setw(10) << "Needed"
+             << setw(10) << "Planned" << setw(10) << "Expected" << "Finish" << endl;
+        int atRisk = 0;
+        for (const auto& entry : courses) {
+            cout << left << setw(24) << entry.courseName
+                 << setw(12) << Calendar::formatIsoDate(entry.examDay)
+                 << setw(10) << TimeSlot::formatHours(entry.requiredMinutes) + "h"
+                 << setw(10) << TimeSlot::formatHours(entry.plannedMinutes) + "h"
+                 << setw(10) << TimeSlot::formatHours((int)llround(entry.expectedMinutes)) + "h"
+                 << fixed << setprecision(1) << entry.completionProbability * 100 << "%" << right << endl;
+            if (entry.completionProbability < 0.9) atRisk++;
+        }
+        cout << "Courses under 90%: " << atRisk << " (" << fixed << setprecision(2) 
+             << milliseconds << " ms)" << endl;
+    }
+};
+
+// Replays a schedule many times with sessions randomly missed or overrun
+// and counts how often each course still gets its remaining hours before
+// the exam. The random numbers are counter-based - the draw for (trial,
+// session) is a hash of the seed and those two counters - so every trial
+// is its own stream, trials can be split across threads in any way, and a
+// seed always gives the same report.
+class CompletionRiskSimulator {
+private:
+    static uint64_t splitmix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+    
+    // Three uniforms in [0, 1) with 21 bits each from one 64-bit draw
+    static void draw(uint64_t seed, uint64_t trial, uint64_t session, double unit[3]) {
+        uint64_t bits = splitmix(splitmix(seed ^ splitmix(trial)) + session);
+        for (int k = 0; k < 3; k++) {
+            unit[k] = (double)((bits >> (21 * k)) & 0x1FFFFF) / (double)(1 << 21);
+        }
+    }
+    
+public:
+    // Sessions of courses not in 'courses' are ignored; a course with
+    // nothing planned simply never finishes
+    static RiskReport simulate(const vector<shared_ptr<Course>>& courses, const Schedule& schedule,
+                               const RiskOptions& options) {
+        auto started = chrono::steady_clock::now();
+        RiskReport report;
+        report.options = options;
+        
+        vector<int> position = schedule.positionsIn(courses);
+        vector<int> required(courses.size()), planned(courses.size(), 0);
+        for (size_t c = 0; c < courses.size(); c++) required[c] = courses[c]->getRemainingHours() * 60;
+        
+        // Flat (course, minutes) pairs are all a trial needs
+        vector<uint32_t> sessionCourse;
+        vector<int> sessionMinutes;
+        for (const auto& session : schedule.getSessions()) {
+            int c = position[session.course];
+            if (c < 0 || session.getDate() >= courses[c]->getExamDay()) continue;
+            sessionCourse.push_back((uint32_t)c);
+            sessionMinutes.push_back(session.getDurationMinutes());
+            planned[c] += session.getDurationMinutes();
+        }
+        
+        // Integer totals per worker, so the sums do not depend on how the
+        // trials were split
+        struct Tally {
+            vector<long long> finished;
+            vector<long long> achievedMinutes;
+        };
+        size_t trials = (size_t)max(0, options.trials);
+        size_t workers = ThreadPool::shared().size();
+        size_t chunk = max<size_t>(1, (trials + workers - 1) / workers);
+        vector<future<Tally>> running;
+        for (size_t begin = 0; begin < trials; begin += chunk) {
+            size_t end = min(trials, begin + chunk);
+            running.push_back(ThreadPool::shared().submit([&, begin, end] {
+                Tally tally;
+                tally.finished.assign(courses.size(), 0);
+                tally.achievedMinutes.assign(courses.size(), 0);
+                vector<double> achieved(courses.size());
+                double unit[3];
+                for (size_t trial = begin; trial < end; trial++) {
+                    fill(achieved.begin(), achieved.end(), 0.0);
+                    for (size_t s = 0; s < sessionCourse.size(); s++) {
+                        draw(options.seed, trial, s, unit);
+                        if (unit[0] < options.missProbability) continue;
+                        double minutes = sessionMinutes[s];
+                        if (unit[1] < options.overrunProbability) {
+                            minutes /= 1.0 + options.overrunFraction * unit[2];
+                        }
+                        achieved[sessionCourse[s]] += minutes;
+                    }
+                    for (size_t c = 0; c < courses.size(); c++) {
+                        if (achieved[c] + 1e-9 >= required[c]) tally.finished[c]++;
+                        tally.achievedMinutes[c] += llround(achieved[c]);
+                    }
+                }
+                return tally;
+            }));
+        }
+        
+        vector<long long> finished(courses.size(), 0), achievedMinutes(courses.size(), 0);
+        for (auto& task : running) {
+            Tally tally = ThreadPool::shared().wait(task);
+            for (size_t c = 0; c < courses.size(); c++) {
+                finished[c] += tally.finished[c];
+                achievedMinutes[c] += tally.achievedMinutes[c];
+            }
+        }
+        
+        for (size_t c = 0; c < courses.size(); c++) {
+            CourseRisk entry;
+            entry.courseName = courses[c]->getName();
+            entry.examDay = courses[c]->getExamDay();
+            entry.requiredMinutes = required[c];
+            entry.plannedMinutes = planned[c];
+            entry.completionProbability = trials > 0 ? (double)finished[c] / trials : 0.0;
+            entry.expectedMinutes = trials > 0 ? (double)achievedMinutes[c] / trials : 0.0;
+            report.courses.push_back(entry);
+        }
+        report.milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+        return report;
+    }
+};
+
+// ==================== SCHEDULE IMPROVER (PARALLEL TEMPERING) ====================
+struct AnnealingOptions {
+    uint64_t seed;
+    int replicas;            // temperature ladder size
+    int movesPerRound;       // moves each replica tries between exchanges
+    int maxRounds;
+    double timeBudgetMs;     // stop early when exceeded (checked between rounds)
+    
+    AnnealingOptions() 
+        : seed(42), replicas(4), movesPerRound(2000), maxRounds(200), timeBudgetMs(500) {}
+};
+
+// Local search over an existing schedule. Sessions are moved to other
+// slot occurrences, split in two, or have their courses swapped; the
+// energy penalizes heavy days, one course hogging a day, cramming right
+// before an exam and (most of all) uncovered hours. Every term is a sum
+// over (day) or (course, day) cells, so a move is scored in O(1) from
+// running counters instead of re-evaluating the schedule. Study limits are
+// hard: moves that break a daily cap are rejected by the same counters,
+// and every session in an occurrence reserves room for a break.
+//
+// Replicas at different temperatures run on the thread pool and swap
+// states between rounds. Each replica has its own seeded generator and
+// exchanges use a separate one, so a run is reproducible from the seed as
+// long as it stops on maxRounds rather than on the time budget.
+class ScheduleAnnealer {
+private:
+    struct Piece {
+        int course;              // index into activeCourses
+        uint32_t occurrence;
+        int minutes;
+    };
+    
+    struct State {
+        vector<Piece> pieces;
+        vector<int> occurrenceUsed;          // minutes booked per occurrence
+        vector<int> occurrenceSessions;      // pieces (and pinned sessions) per occurrence
+        vector<int> dayLoad;                 // minutes per day since horizon start
+        unordered_map<uint64_t, int> courseDay;
+        vector<int> courseTotal;
+        double energy;
+    };
+    
+    const vector<shared_ptr<Course>>& courses;
+    const SlotHorizon& horizon;
+    StudyLimits limits;
+    vector<int> required;                    // minutes per course
+    vector<int> examDay;
+    vector<uint32_t> beforeExam;             // first occurrence id on/after the exam
+    
+    static constexpr double COVERAGE_WEIGHT = 50.0;
+    static constexpr double LOAD_WEIGHT = 1.0;
+    static constexpr double HOG_WEIGHT = 1.0;
+    static constexpr double CRAM_WEIGHT = 2.0;
+    
+    static uint64_t cell(int course, int day) {
+        return ((uint64_t)(uint32_t)course << 32) | (uint32_t)day;
+    }
+    
+    int dayOf(uint32_t occurrence) const {
+        return horizon.at(occurrence).day - horizon.getStartDay();
+    }
+    
+    // Add 'minutes' (may be negative) of 'course' on 'day' and return the
+    // energy change. Applying the negated change restores the state.
+    double apply(State& state, int course, int day, int minutes) const {
+        double delta = 0;
+        double hours = minutes / 60.0;
+        
+        double load = state.dayLoad[day] / 60.0;
+        delta += LOAD_WEIGHT * ((load + hours) * (load + hours) - load * load);
+        state.dayLoad[day] += minutes;
+        
+        if (course < 0) return delta;
+        
+        int& own = state.courseDay[cell(course, day)];
+        double ownHours = own / 60.0;
+        delta += HOG_WEIGHT * ((ownHours + hours) * (ownHours + hours) - ownHours * ownHours);
+        own += minutes;
+        
+        int daysLeft = examDay[course] - (horizon.getStartDay() + day);
+        delta += CRAM_WEIGHT * hours * max(0, 3 - daysLeft) / 3.0;
+        
+        int before = max(0, required[course] - state.courseTotal[course]);
+        state.courseTotal[course] += minutes;
+        int after = max(0, required[course] - state.courseTotal[course]);
+        delta += COVERAGE_WEIGHT * (after - before) / 60.0;
+        return delta;
+    }
+    
+    // Room for one more session, after the break it would need
+    int freeMinutes(const State& state, uint32_t occurrence) const {
+        return horizon.at(occurrence).getDurationMinutes() - state.occurrenceUsed[occurrence]
+             - state.occurrenceSessions[occurrence] * limits.minBreakMinutes;
+    }
+    
+    // Would 'course' stay within its cap on 'day' after gaining 'added'
+    // and losing 'removed' minutes there? Never blocks a change that
+    // lowers the load.
+    bool withinCourseCap(const State& state, int course, int day, int added, int removed) const {
+        if (limits.maxCourseMinutesPerDay <= 0 || added <= removed) return true;
+        auto it = state.courseDay.find(cell(course, day));
+        int current = it == state.courseDay.end() ? 0 : it->second;
+        return current + added - removed <= limits.maxCourseMinutesPerDay;
+    }
+    
+    bool withinDayCap(const State& state, int day, int added) const {
+        return limits.maxMinutesPerDay <= 0 || state.dayLoad[day] + added <= limits.maxMinutesPerDay;
+    }
+    
+    // One Metropolis step; returns true if the move was kept
+    bool step(State& state, double temperature, mt19937_64& rng) const {
+        if (state.pieces.empty()) return false;
+        uniform_int_distribution<size_t> anyPiece(0, state.pieces.size() - 1);
+        uniform_real_distribution<double> unit(0.0, 1.0);
+        size_t p = anyPiece(rng);
+        Piece piece = state.pieces[p];
+        
+        auto accept = [&](double delta) {
+            return delta <= 0 || unit(rng) < exp(-delta / temperature);
+        };
+        
+        int kind = (int)(unit(rng) * 3);
+        if (kind == 0 || kind == 2) {
+            // Move the whole piece, or (split) the back half of it
+            int moving = piece.minutes;
+            if (kind == 2) {
+                if (piece.minutes < 60) return false;
+                moving = piece.minutes / 2 / 15 * 15;
+            }
+            if (beforeExam[piece.course] == 0) return false;
+            uniform_int_distribution<uint32_t> anyOccurrence(0, beforeExam[piece.course] - 1);
+            uint32_t target = anyOccurrence(rng);
+            if (target == piece.occurrence || freeMinutes(state, target) < moving) return false;
+            
+            int from = dayOf(piece.occurrence), to = dayOf(target);
+            if (from != to && (!withinDayCap(state, to, moving) || 
+                               !withinCourseCap(state, piece.course, to, moving, 0))) return false;
+            double delta = apply(state, piece.course, from, -moving) 
+                         + apply(state, piece.course, to, moving);
+            if (!accept(delta)) {
+                apply(state, piece.course, to, -moving);
+                apply(state, piece.course, from, moving);
+                return false;
+            }
+            state.occurrenceUsed[piece.occurrence] -= moving;
+            state.occurrenceUsed[target] += moving;
+            state.occurrenceSessions[target]++;
+            if (moving == piece.minutes) {
+                state.pieces[p].occurrence = target;
+                state.occurrenceSessions[piece.occurrence]--;
+            } else {
+                state.pieces[p].minutes -= moving;
+                state.pieces.push_back({piece.course, target, moving});
+            }
+            state.energy += delta;
+            return true;
+        }
+        
+        // Swap courses between two pieces; each stays in its slot
+        size_t q = anyPiece(rng);
+        Piece other = state.pieces[q];
+        if (other.course == piece.course) return false;
+        if (other.occurrence >= beforeExam[piece.course] || 
+            piece.occurrence >= beforeExam[other.course]) return false;
+        
+        int dayP = dayOf(piece.occurrence), dayQ = dayOf(other.occurrence);
+        bool sameDay = dayP == dayQ;
+        if (!withinCourseCap(state, piece.course, dayQ, other.minutes, sameDay ? piece.minutes : 0) ||
+            !withinCourseCap(state, other.course, dayP, piece.minutes, sameDay ? other.minutes : 0)) {
+            return false;
+        }
+        double delta = apply(state, piece.course, dayP, -piece.minutes)
+                     + apply(state, other.course, dayQ, -other.minutes)
+                     + apply(state, other.course, dayP, piece.minutes)
+                     + apply(state, piece.course, dayQ, other.minutes);
+        if (!accept(delta)) {
+            apply(state, piece.course, dayQ, -other.minutes);
+            apply(state, other.course, dayP, -piece.minutes);
+            apply(state, other.course, dayQ, other.minutes);
+            apply(state, piece.course, dayP, piece.minutes);
+            return false;
+        }
+        swap(state.pieces[p].course, state.pieces[q].course);
+        state.energy += delta;
+        return true;
+    }
+    
+    // Locate the occurrence a session was booked in
+    bool findOccurrence(const StudySession& session, uint32_t& occurrence) const {
+        SlotOccurrence found;
+        if (!horizon.locate(session.getDate(), session.getStartMinute(), found)) return false;
+        occurrence = found.id;
+        return true;
+    }
+    
+public:
+    ScheduleAnnealer(const vector<shared_ptr<Course>>& activeCourses, const SlotHorizon& h,
+                     const StudyLimits& studyLimits = StudyLimits())
+        : courses(activeCourses), horizon(h), limits(studyLimits) {
+        for (const auto& course : courses) {
+            required.push_back(course->getRemainingHours() * 60);
+            examDay.push_back(course->getExamDay());
+            beforeExam.push_back(horizon.firstOnOrAfter(course->getExamDay()));
+        }
+    }
+    
+    Schedule improve(const Schedule& start, const AnnealingOptions& options) const {
+        // Build the starting state from the given schedule
+        vector<int> courseIndex = start.positionsIn(courses);
+        
+        State initial;
+        initial.occurrenceUsed.assign(horizon.size(), 0);
+        initial.occurrenceSessions.assign(horizon.size(), 0);
+        initial.dayLoad.assign(horizon.getEndDay() - horizon.getStartDay() + 1, 0);
+        initial.courseTotal.assign(courses.size(), 0);
+        initial.energy = 0;
+        for (int c = 0; c < (int)courses.size(); c++) {
+            initial.energy += COVERAGE_WEIGHT * required[c] / 60.0;
+        }
+        
+        // Sessions outside this horizon are passed through; sessions of
+        // courses that are no longer active keep their occurrence and length
+        vector<StudySession> untouched;
+        map<uint32_t, vector<StudySession>> pinned;
+        for (const auto& session : start.getSessions()) {
+            uint32_t occurrence;
+            if (!findOccurrence(session, occurrence)) {
+                untouched.push_back(session);
+                continue;
+            }
+            int minutes = session.getDurationMinutes();
+            int course = courseIndex[session.course];
+            if (course < 0) {
+                pinned[occurrence].push_back(session);
+                initial.occurrenceUsed[occurrence] += minutes;
+                initial.occurrenceSessions[occurrence]++;
+                initial.energy += apply(initial, -1, dayOf(occurrence), minutes);
+                continue;
+            }
+            initial.pieces.push_back({course, occurrence, minutes});
+            initial.occurrenceUsed[occurrence] += minutes;
+            initial.occurrenceSessions[occurrence]++;
+            initial.energy += apply(initial, course, dayOf(occurrence), minutes);
+        }
+        
+        // Temperature ladder and per-replica generators
+        int replicaCount = max(1, options.replicas);
+        vector<State> replicas(replicaCount, initial);
+        vector<double> temperature(replicaCount);
+        vector<mt19937_64> rngs;
+        for (int r = 0; r < replicaCount; r++) {
+            temperature[r] = 0.05 * pow(10.0, replicaCount > 1 ? 2.0 * r / (replicaCount - 1) : 0.0);
+            rngs.emplace_back(options.seed * 0x9E3779B97F4A7C15ULL + r);
+        }
+        mt19937_64 exchangeRng(options.seed ^ 0xD1B54A32D192ED03ULL);
+        uniform_real_distribution<double> unit(0.0, 1.0);
+        
+        State best = initial;
+        auto startTime = chrono::steady_clock::now();
+        for (int round = 0; round < options.maxRounds; round++) {
+            chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - startTime;
+            if (elapsed.count() > options.timeBudgetMs) break;
+            
+            vector<future<void>> running;
+            for (int r = 0; r < replicaCount; r++) {
+                running.push_back(ThreadPool::shared().submit([&, r] {
+                    for (int m = 0; m < options.movesPerRound; m++) {
+                        step(replicas[r], temperature[r], rngs[r]);
+                    }
+                }));
+            }
+            for (auto& task : running) ThreadPool::shared().wait(task);
+            
+            for (int r = 0; r + 1 < replicaCount; r++) {
+                double exponent = (replicas[r].energy - replicas[r + 1].energy) * 
+                                  (1.0 / temperature[r] - 1.0 / temperature[r + 1]);
+                if (exponent >= 0 || unit(exchangeRng) < exp(exponent)) {
+                    swap(replicas[r], replicas[r + 1]);
+                }
+            }
+            for (const auto& replica : replicas) {
+                if (replica.energy < best.energy - 1e-9) best = replica;
+            }
+        }
+        
+        return toSchedule(best, start, untouched, pinned);
+    }
+    
+    // Lay out each occurrence from its start, a break apart: first its
+    // pinned sessions in their original order, then the pieces, merging
+    // pieces of the same course. Pinned sessions may shift within their
+    // occurrence, but the occurrence always has room for all of them
+    // (freeMinutes counts them). 'untouched' sessions are copied over.
+    Schedule toSchedule(const State& state, const Schedule& start, const vector<StudySession>& untouched,
+                        map<uint32_t, vector<StudySession>> pinned) const {
+        map<pair<uint32_t, int>, int> merged;   // (occurrence, course) -> minutes
+        for (const auto& piece : state.pieces) {
+            if (piece.minutes > 0) merged[make_pair(piece.occurrence, piece.course)] += piece.minutes;
+        }
+        
+        Schedule result("Improved Study Schedule");
+        map<uint32_t, int> cursor;
+        auto place = [&](const SlotOccurrence& occ, const shared_ptr<Course>& course, int minutes) {
+            int& at = cursor.emplace(occ.id, occ.startMinute).first->second;
+            if (at > occ.startMinute) at += limits.minBreakMinutes;
+            result.addSession(course, occ.day, at, minutes);
+            at += minutes;
+        };
+        for (auto& entry : pinned) {
+            SlotOccurrence occ = horizon.at(entry.first);
+            sort(entry.second.begin(), entry.second.end(),
+                 [](const StudySession& a, const StudySession& b) { return a.startMinute < b.startMinute; });
+            for (const auto& session : entry.second) place(occ, start.getCourse(session), session.minutes);
+        }
+        long long booked = 0;
+        for (const auto& entry : merged) {
+            place(horizon.at(entry.first.first), courses[entry.first.second], entry.second);
+            booked += entry.second;
+        }
+        for (const auto& session : untouched) result.addSession(start, session);
+        result.setUtilization(booked, horizon.capacityBefore(horizon.getEndDay()));
+        return result;
+    }
+};
+
+// ==================== PARETO FRONTIER ====================
+struct ParetoOptions {
+    uint64_t seed;
+    int population;
+    int generations;
+    double timeBudgetMs;     // stop early when exceeded (checked between generations)
+    
+    ParetoOptions() : seed(42), population(48), generations(60), timeBudgetMs(2000) {}
+};
+
+// Turns a genome into a schedule. A genome is the order courses book in,
+// whether they book all at once or take turns, and per course the longest
+// session it books at once and how far into its window it starts; each
+// course then books one session per occurrence from there, wrapping back
+// to the start of its window. Decoding is deterministic, so a frontier
+// keeps a few bytes per course instead of copies of every session.
+class ScheduleDecoder {
+private:
+    vector<shared_ptr<Course>> courses;
+    SlotHorizon horizon;
+    StudyLimits limits;
+    vector<uint32_t> beforeExam;    // first occurrence id on/after each exam
+    
+public:
+    ScheduleDecoder(const vector<shared_ptr<Course>>& active, const SlotHorizon& h, 
+                    const StudyLimits& studyLimits)
+        : courses(active), horizon(h), limits(studyLimits) {
+        for (const auto& course : courses) beforeExam.push_back(horizon.firstOnOrAfter(course->getExamDay()));
+    }
+    
+    size_t courseCount() const { return courses.size(); }
+    const vector<shared_ptr<Course>>& getCourses() const { return courses; }
+    const SlotHorizon& getHorizon() const { return horizon; }
+    
+    // 'order' lists every course position once; 'quarters' is the longest
+    // session in quarter hours and 'lateness' (0..255) the share of the
+    // window skipped before the first session, both by course position.
+    // With 'inTurns' each course books one session per round, otherwise
+    // a course books all its time before the next one starts.
+    Schedule decode(const uint32_t* order, const uint8_t* quarters, const uint8_t* lateness,
+                    bool inTurns) const {
+        Schedule schedule("Pareto Study Schedule");
+        SlotAllocator allocator(horizon, SlotAllocator::FIRST_AVAILABLE, limits);
+        SlotAllocator::Booking booking;
+        
+        size_t n = courses.size();
+        vector<int> remaining(n);
+        vector<uint32_t> from(n);
+        for (size_t c = 0; c < n; c++) {
+            remaining[c] = courses[c]->getRemainingHours() * 60;
+            from[c] = (uint32_t)((uint64_t)beforeExam[c] * lateness[c] / 256);
+        }
+        // One session of course c; false once nothing is left for it
+        auto bookOne = [&](uint32_t c) {
+            int longest = max(2, (int)quarters[c]) * 15;
+            while (!allocator.allocate(min(remaining[c], longest), beforeExam[c], booking, c, from[c])) {
+                if (from[c] == 0) {
+                    remaining[c] = 0;
+                    return false;
+                }
+                from[c] = 0;
+            }
+            schedule.addSession(courses[c], booking.occurrence.day, booking.startMinute, booking.minutes);
+            remaining[c] -= booking.minutes;
+            from[c] = booking.occurrence.id + 1 < beforeExam[c] ? booking.occurrence.id + 1 : 0;
+            return true;
+        };
+        
+        if (inTurns) {
+            bool progress = true;
+            while (progress) {
+                progress = false;
+                for (size_t k = 0; k < n; k++) {
+                    if (remaining[order[k]] > 0 && bookOne(order[k])) progress = true;
+                }
+            }
+        } else {
+            for (size_t k = 0; k < n; k++) {
+                while (remaining[order[k]] > 0 && bookOne(order[k])) {}
+            }
+        }
+        schedule.setUtilization(allocator.getBookedMinutes(), allocator.getTotalMinutes());
+        return schedule;
+    }
+};
+
+// Non-dominated schedules, kept as genomes in flat arrays (courseCount
+// entries per point) and decoded on request
+class ParetoFrontier {
+private:
+    shared_ptr<const ScheduleDecoder> decoder;
+    vector<ScheduleObjectives> points;
+    vector<uint32_t> orders;
+    vector<uint8_t> quarters;
+    vector<uint8_t> lateness;
+    vector<bool> inTurns;           // one per point
+    
+public:
+    ParetoFrontier() {}
+    explicit ParetoFrontier(shared_ptr<const ScheduleDecoder> d) : decoder(d) {}
+    
+    void add(const ScheduleObjectives& objectives, const vector<uint32_t>& order,
+             const vector<uint8_t>& longest, const vector<uint8_t>& late, bool turns) {
+        points.push_back(objectives);
+        inTurns.push_back(turns);
+        orders.insert(orders.end(), order.begin(), order.end());
+        quarters.insert(quarters.end(), longest.begin(), longest.end());
+        lateness.insert(lateness.end(), late.begin(), late.end());
+    }
+    
+    size_t size() const { return points.size(); }
+    bool empty() const { return points.empty(); }
+    const ScheduleObjectives& objectives(size_t k) const { return points[k]; }
+    const vector<shared_ptr<Course>>& getCourses() const { return decoder->getCourses(); }
+    
+    Schedule schedule(size_t k) const {
+        size_t n = decoder->courseCount();
+        return decoder->decode(orders.data() + k * n, quarters.data() + k * n, lateness.data() + k * n,
+                               inTurns[k]);
+    }
+    
+    // The point a single-answer caller should get
+    size_t bestCombined() const {
+        size_t best = 0;
+        for (size_t k = 1; k < points.size(); k++) {
+            if (points[k].combined() > points[best].combined()) best = k;
+        }
+        return best;
+    }
+    
+    size_t memoryBytes() const {
+        return points.size() * sizeof(ScheduleObjectives) + orders.size() * sizeof(uint32_t)
+             + quarters.size() + lateness.size() + (inTurns.size() + 7) / 8;
+    }
+    
+    void display() const {
+        cout << "\n=== Trade-offs (Pareto frontier) ===" << endl;
+        if (points.empty()) {
+            cout << "No schedules found." << endl;
+            return;
+        }
+        cout << left << setw(6) << "Plan" << setw(10) << "Coverage" << setw(10) << "Balance"
+             << setw(11) << "Earliness" << "Combined" << endl;
+        for (size_t k = 0; k < points.size(); k++) {
+            cout << left << setw(6) << k + 1 << fixed << setprecision(3)
+                 << setw(10) << points[k].coverage << setw(10) << points[k].balance
+                 << setw(11) << points[k].earliness << points[k].combined() << right << endl;
+        }
+        cout << "No plan beats another on all three; stored in " << memoryBytes() << " bytes." << endl;
+    }
+};
+
+// NSGA-II style evolutionary search. Each generation breeds a population
+// of offspring by tournament, order crossover and mutation, decodes and
+// scores them in parallel on the thread pool, and keeps the best by
+// non-dominated rank, then crowding distance. Offspring are bred from one
+// seeded generator on the calling thread, so a run is reproducible from
+// the seed as long as it stops on generations rather than the time budget.
+class ParetoSearch {
+private:
+    struct Individual {
+        vector<uint32_t> order;
+        vector<uint8_t> quarters;
+        vector<uint8_t> lateness;
+        bool inTurns;
+        ScheduleObjectives objectives;
+        int rank;
+        double crowding;
+    };
+    
+    shared_ptr<const ScheduleDecoder> decoder;
+    
+    static double component(const ScheduleObjectives& o, int m) {
+        return m == 0 ? o.coverage : (m == 1 ? o.balance : o.earliness);
+    }
+    
+    static bool dominates(const ScheduleObjectives& a, const ScheduleObjectives& b) {
+        bool better = false;
+        for (int m = 0; m < 3; m++) {
+            if (component(a, m) < component(b, m)) return false;
+            if (component(a, m) > component(b, m)) better = true;
+        }
+        return better;
+    }
+    
+    // Fast non-dominated sort, O(N^2), then crowding distance per front.
+    // Returns the fronts, best first.
+    static vector<vector<size_t>> rankAndCrowd(vector<Individual>& population) {
+        size_t n = population.size();
+        vector<vector<size_t>> beats(n);
+        vector<int> beatenBy(n, 0);
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = i + 1; j < n; j++) {
+                if (dominates(population[i].objectives, population[j].objectives)) {
+                    beats[i].push_back(j);
+                    beatenBy[j]++;
+                } else if (dominates(population[j].objectives, population[i].objectives)) {
+                    beats[j].push_back(i);
+                    beatenBy[i]++;
+                }
+            }
+        }
+        
+        vector<vector<size_t>> fronts;
+        vector<size_t> current;
+        for (size_t i = 0; i < n; i++) if (beatenBy[i] == 0) current.push_back(i);
+        while (!current.empty()) {
+            vector<size_t> next;
+            for (size_t i : current) {
+                population[i].rank = (int)fronts.size();
+                population[i].crowding = 0;
+                for (size_t j : beats[i]) {
+                    if (--beatenBy[j] == 0) next.push_back(j);
+                }
+            }
+            for (int m = 0; m < 3; m++) {
+                vector<size_t> sorted = current;
+                stable_sort(sorted.begin(), sorted.end(), [&](size_t a, size_t b) {
+                    return component(population[a].objectives, m) < component(population[b].objectives, m);
+                });
+                double low = component(population[sorted.front()].objectives, m);
+                double high = component(population[sorted.back()].objectives, m);
+                population[sorted.front()].crowding = population[sorted.back()].crowding = 1e18;
+                if (high - low <= 0) continue;
+                for (size_t k = 1; k + 1 < sorted.size(); k++) {
+                    population[sorted[k]].crowding += 
+                        (component(population[sorted[k + 1]].objectives, m) -
+                         component(population[sorted[k - 1]].objectives, m)) / (high - low);
+                }
+            }
+            fronts.push_back(current);
+            current = next;
+        }
+        return fronts;
+    }
+    
+    void evaluate(vector<Individual>& population, size_t from) const {
+        vector<future<void>> running;
+        for (size_t i = from; i < population.size(); i++) {
+            running.push_back(ThreadPool::shared().submit([this, &population, i] {
+                Individual& one = population[i];
+                Schedule schedule = decoder->decode(one.order.data(), one.quarters.data(), 
+                                                    one.lateness.data(), one.inTurns);
+                one.objectives = ScheduleObjectives::evaluate(schedule, decoder->getCourses(), 
+                                                              decoder->getHorizon());
+            }));
+        }
+        for (auto& task : running) ThreadPool::shared().wait(task);
+    }
+    
+    // Binary tournament among the first 'size' (ranked) individuals
+    static const Individual& tournament(const vector<Individual>& population, size_t size, 
+                                        mt19937_64& rng) {
+        uniform_int_distribution<size_t> any(0, size - 1);
+        const Individual& a = population[any(rng)];
+        const Individual& b = population[any(rng)];
+        if (a.rank != b.rank) return a.rank < b.rank ? a : b;
+        return a.crowding >= b.crowding ? a : b;
+    }
+    
+    Individual breed(const Individual& a, const Individual& b, mt19937_64& rng) const {
+        size_t n = a.order.size();
+        uniform_int_distribution<size_t> anyPosition(0, n - 1);
+        uniform_real_distribution<double> unit(0.0, 1.0);
+        Individual child;
+        
+        // Order crossover: a slice of a's order, the rest in b's order
+        size_t first = anyPosition(rng), last = anyPosition(rng);
+        if (first > last) swap(first, last);
+        vector<bool> taken(n, false);
+        child.order.assign(n, 0);
+        for (size_t k = first; k <= last; k++) {
+            child.order[k] = a.order[k];
+            taken[a.order[k]] = true;
+        }
+        size_t fill = (last + 1) % n;
+        for (size_t k = 0; k < n; k++) {
+            uint32_t course = b.order[(last + 1 + k) % n];
+            if (taken[course]) continue;
+            child.order[fill] = course;
+            fill = (fill + 1) % n;
+        }
+        
+        child.inTurns = unit(rng) < 0.5 ? a.inTurns : b.inTurns;
+        child.quarters.resize(n);
+        child.lateness.resize(n);
+        for (size_t c = 0; c < n; c++) {
+            bool fromA = unit(rng) < 0.5;
+            child.quarters[c] = fromA ? a.quarters[c] : b.quarters[c];
+            child.lateness[c] = fromA ? a.lateness[c] : b.lateness[c];
+        }
+        
+        // Mutation: swap two courses in the order, rarely switch between
+        // turns and all at once, and nudge about one course's genes
+        if (n > 1 && unit(rng) < 0.5) swap(child.order[anyPosition(rng)], child.order[anyPosition(rng)]);
+        if (unit(rng) < 0.05) child.inTurns = !child.inTurns;
+        for (size_t c = 0; c < n; c++) {
+            if (unit(rng) * n >= 1.0) continue;
+            if (unit(rng) < 0.5) {
+                child.quarters[c] = (uint8_t)uniform_int_distribution<int>(2, 12)(rng);
+            } else {
+                child.lateness[c] = (uint8_t)uniform_int_distribution<int>(0, 255)(rng);
+            }
+        }
+        return child;
+    }
+    
+public:
+    explicit ParetoSearch(shared_ptr<const ScheduleDecoder> d) : decoder(d) {}
+    
+    // 'startOrders' seed the first population (e.g. the orders the greedy
+    // strategies use); the rest is random
+    ParetoFrontier run(const ParetoOptions& options, const vector<vector<uint32_t>>& startOrders) const {
+        ParetoFrontier frontier(decoder);
+        size_t n = decoder->courseCount();
+        size_t size = (size_t)max(4, options.population);
+        if (n == 0) return frontier;
+        
+        mt19937_64 rng(options.seed);
+        vector<Individual> population;
+        for (const auto& order : startOrders) {
+            for (bool turns : {false, true}) {
+                if (population.size() >= size || order.size() != n) continue;
+                Individual one;
+                one.order = order;
+                one.inTurns = turns;
+                one.quarters.assign(n, turns ? 8 : 12);
+                one.lateness.assign(n, 0);
+                population.push_back(one);
+            }
+        }
+        while (population.size() < size) {
+            Individual one;
+            one.order.resize(n);
+            for (uint32_t c = 0; c < n; c++) one.order[c] = c;
+            shuffle(one.order.begin(), one.order.end(), rng);
+            one.inTurns = rng() % 2 == 0;
+            for (size_t c = 0; c < n; c++) {
+                one.quarters.push_back((uint8_t)uniform_int_distribution<int>(2, 12)(rng));
+                one.lateness.push_back((uint8_t)uniform_int_distribution<int>(0, 255)(rng));
+            }
+            population.push_back(one);
+        }
+        evaluate(population, 0);
+        rankAndCrowd(population);
+        
+        auto startTime = chrono::steady_clock::now();
+        for (int generation = 0; generation < options.generations; generation++) {
+            chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - startTime;
+            if (elapsed.count() > options.timeBudgetMs) break;
+            
+            population.reserve(2 * size);
+            for (size_t k = 0; k < size; k++) {
+                const Individual& a = tournament(population, size, rng);
+                const Individual& b = tournament(population, size, rng);
+                population.push_back(breed(a, b, rng));
+            }
+            evaluate(population, size);
+            
+            // Keep whole fronts while they fit, then the most spread-out
+            // members of the front that does not
+            vector<vector<size_t>> fronts = rankAndCrowd(population);
+            vector<Individual> survivors;
+            for (auto& front : fronts) {
+                if (survivors.size() + front.size() > size) {
+                    stable_sort(front.begin(), front.end(), [&](size_t a, size_t b) {
+                        return population[a].crowding > population[b].crowding;
+                    });
+                }
+                for (size_t i : front) {
+                    if (survivors.size() == size) break;
+                    survivors.push_back(move(population[i]));
+                }
+                if (survivors.size() == size) break;
+            }
+            population = move(survivors);
+            rankAndCrowd(population);
+        }
+        
+        // First front, one genome per distinct score, highest coverage first
+        vector<size_t> best;
+        for (size_t i = 0; i < population.size(); i++) {
+            if (population[i].rank == 0) best.push_back(i);
+        }
+        stable_sort(best.begin(), best.end(), [&](size_t a, size_t b) {
+            const auto& x = population[a].objectives;
+            const auto& y = population[b].objectives;
+            if (x.coverage != y.coverage) return x.coverage > y.coverage;
+            if (x.balance != y.balance) return x.balance > y.balance;
+            return x.earliness > y.earliness;
+        });
+        for (size_t k = 0; k < best.size(); k++) {
+            const Individual& one = population[best[k]];
+            if (k > 0) {
+                const auto& previous = population[best[k - 1]].objectives;
+                if (previous.coverage == one.objectives.coverage && previous.balance == one.objectives.balance &&
+                    previous.earliness == one.objectives.earliness) continue;
+            }
+            frontier.add(one.objectives, one.order, one.quarters, one.lateness, one.inTurns);
+        }
+        return frontier;
+    }
+};
+
+// ==================== INCREMENTAL RESCHEDULING ====================
+// Sessions added and removed by one change
+struct ScheduleDiff {
+    Schedule added;
+    Schedule removed;
+    
+    ScheduleDiff() : added("Added sessions"), removed("Removed sessions") {}
+    
+    bool empty() const { return added.getSessions().empty() && removed.getSessions().empty(); }
+    
+    static void displayLines(const Schedule& part, const char* mark) {
+        for (const auto& session : part.getSessions()) {
+            TimeSlot slot = session.getTimeSlot();
+            cout << "  " << mark << " " << part.getCourse(session)->getName() << " " 
+                 << Calendar::formatIsoDate(session.getDate()) << " "
+                 << slot.getStartTime() << "-" << slot.getEndTime() << endl;
+        }
+    }
+    
+    void display() const {
+        if (empty()) {
+            cout << "Schedule unchanged." << endl;
+            return;
+        }
+        cout << "Schedule changes:" << endl;
+        displayLines(removed, "-");
+        displayLines(added, "+");
+    }
+};
+
+// Keeps a generated schedule live. Each session is indexed by course and
+// by weekly slot, and slot capacity is tracked in a SlotAllocator, so a
+// change only touches the sessions that depend on it:
+//   - progress on a course trims that course's latest sessions
+//   - a removed slot drops its sessions and re-places those hours
+//   - a moved exam drops sessions on/after the new date and tops the
+//     course back up before it
+// Everything else stays where it was.
+class IncrementalScheduler {
+private:
+    struct LiveSession {
+        int course;
+        SlotOccurrence occurrence;
+        int startMinute;          // minutes since midnight
+        int minutes;
+        bool live;
+    };
+    
+    vector<shared_ptr<Course>> courses;
+    map<const Course*, int> courseIndex;
+    vector<TimeSlot> slots;
+    SlotHorizon horizon;
+    SlotAllocator allocator;
+    
+    vector<LiveSession> sessions;
+    vector<vector<uint32_t>> sessionsByCourse;
+    unordered_map<uint32_t, vector<uint32_t>> sessionsBySlot;
+    vector<int> scheduledMinutes;
+    
+    void addTo(Schedule& schedule, const LiveSession& session) const {
+        schedule.addSession(courses[session.course], session.occurrence.day, session.startMinute, session.minutes);
+    }
+    
+    void track(int course, const SlotOccurrence& occ, int startMinute, int minutes) {
+        uint32_t id = (uint32_t)sessions.size();
+        sessions.push_back({course, occ, startMinute, minutes, true});
+        sessionsByCourse[course].push_back(id);
+        sessionsBySlot[occ.slotIndex].push_back(id);
+        scheduledMinutes[course] += minutes;
+    }
+    
+    void drop(uint32_t id, ScheduleDiff& diff) {
+        LiveSession& session = sessions[id];
+        if (!session.live) return;
+        session.live = false;
+        allocator.release(session.occurrence, session.startMinute, session.minutes, session.course);
+        scheduledMinutes[session.course] -= session.minutes;
+        addTo(diff.removed, session);
+    }
+    
+    // Book whatever the course still lacks before its exam
+    void topUp(int course, ScheduleDiff& diff) {
+        int missing = courses[course]->getRemainingHours() * 60 - scheduledMinutes[course];
+        uint32_t beforeExam = horizon.firstOnOrAfter(courses[course]->getExamDay());
+        SlotAllocator::Booking booking;
+        while (missing > 0 && allocator.allocate(missing, beforeExam, booking, course)) {
+            track(course, booking.occurrence, booking.startMinute, booking.minutes);
+            addTo(diff.added, sessions.back());
+            missing -= booking.minutes;
+        }
+    }
+    
+    // Remove the latest sessions until at most 'target' minutes remain;
+    // the last one dropped may be shortened instead
+    void trimTo(int course, int target, ScheduleDiff& diff) {
+        auto& ids = sessionsByCourse[course];
+        sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+            if (sessions[a].occurrence.day != sessions[b].occurrence.day) {
+                return sessions[a].occurrence.day < sessions[b].occurrence.day;
+            }
+            return sessions[a].startMinute < sessions[b].startMinute;
+        });
+        while (scheduledMinutes[course] > target && !ids.empty()) {
+            uint32_t id = ids.back();
+            ids.pop_back();
+            if (!sessions[id].live) continue;
+            
+            int excess = scheduledMinutes[course] - target;
+            LiveSession kept = sessions[id];
+            drop(id, diff);
+            if (excess < kept.minutes) {
+                int minutes = kept.minutes - excess;
+                allocator.book(kept.occurrence, kept.startMinute, minutes, course);
+                track(course, kept.occurrence, kept.startMinute, minutes);
+                addTo(diff.added, sessions.back());
+            }
+        }
+    }
+    
+public:
+    IncrementalScheduler(const vector<shared_ptr<Course>>& activeCourses, 
+                         const vector<TimeSlot>& weeklySlots, int startDay, int endDay,
+                         const Schedule& initial, const StudyLimits& limits = StudyLimits())
+        : courses(activeCourses), slots(weeklySlots), 
+          horizon(weeklySlots, startDay, endDay),
+          allocator(horizon, SlotAllocator::FIRST_FIT, limits),
+          sessionsByCourse(activeCourses.size()), scheduledMinutes(activeCourses.size(), 0) {
+        for (size_t i = 0; i < courses.size(); i++) courseIndex[courses[i].get()] = (int)i;
+        
+        vector<int> position = initial.positionsIn(courses);
+        for (const auto& session : initial.getSessions()) {
+            int course = position[session.course];
+            int start = session.getStartMinute();
+            SlotOccurrence occ;
+            if (course < 0 || !horizon.locate(session.getDate(), start, occ)) continue;
+            if (allocator.book(occ, start, session.getDurationMinutes(), course)) {
+                track(course, occ, start, session.getDurationMinutes());
+            }
+        }
+    }
+    
+    // Call after the course's completed hours changed
+    ScheduleDiff courseProgressed(const Course* course) {
+        ScheduleDiff diff;
+        auto it = courseIndex.find(course);
+        if (it == courseIndex.end()) return diff;
+        
+        int needed = course->getRemainingHours() * 60;
+        if (scheduledMinutes[it->second] > needed) trimTo(it->second, needed, diff);
+        else topUp(it->second, diff);
+        return diff;
+    }
+    
+    bool tracks(const Course* course) const { return courseIndex.count(course) > 0; }
+    
+    // Call after a weekly slot was deleted. Every slot touching the removed
+    // time takes no new bookings; sessions inside that time are re-placed.
+    ScheduleDiff slotRemoved(const TimeSlot& removed) {
+        ScheduleDiff diff;
+        set<int> affected;
+        for (uint32_t index = 0; index < slots.size(); index++) {
+            if (!slots[index].overlaps(removed)) continue;
+            
+            allocator.blockSlot(index);
+            auto it = sessionsBySlot.find(index);
+            if (it == sessionsBySlot.end()) continue;
+            int dayOffset = slots[index].getDayIndex() * TimeSlot::MINUTES_PER_DAY;
+            vector<uint32_t> kept;
+            for (uint32_t id : it->second) {
+                TimeSlot booked(dayOffset + sessions[id].startMinute,
+                                dayOffset + sessions[id].startMinute + sessions[id].minutes);
+                if (!booked.overlaps(removed)) {
+                    kept.push_back(id);
+                    continue;
+                }
+                if (sessions[id].live) affected.insert(sessions[id].course);
+                drop(id, diff);
+            }
+            if (kept.empty()) sessionsBySlot.erase(it);
+            else it->second = move(kept);
+        }
+        for (int course : affected) topUp(course, diff);
+        return diff;
+    }
+    
+    // Call after the course's exam date changed
+    ScheduleDiff examMoved(const Course* course) {
+        ScheduleDiff diff;
+        auto it = courseIndex.find(course);
+        if (it == courseIndex.end()) return diff;
+        
+        // A later exam may need more weeks; occurrence ids keep their
+        // meaning because the horizon start doesn't move
+        if (course->getExamDay() > horizon.getEndDay()) {
+            horizon = SlotHorizon(slots, horizon.getStartDay(), course->getExamDay());
+        }
+        for (uint32_t id : sessionsByCourse[it->second]) {
+            if (sessions[id].live && sessions[id].occurrence.day >= course->getExamDay()) {
+                drop(id, diff);
+            }
+        }
+        topUp(it->second, diff);
+        return diff;
+    }
+    
+    Schedule currentSchedule() const {
+        Schedule schedule("Optimized Study Schedule");
+        for (const auto& session : sessions) {
+            if (session.live) addTo(schedule, session);
+        }
+        schedule.setUtilization(allocator.getBookedMinutes(), allocator.getTotalMinutes());
+        return schedule;
+    }
+};
+
+// ==================== MIN-COST FLOW SOLVER (CSR) ====================
+// Successive shortest paths with Johnson potentials. Edges are collected
+// first and then laid out in compressed sparse row order (one contiguous
+// run per node, struct-of-arrays), so Dijkstra's inner loop walks memory
+// linearly instead of chasing per-node vectors.
+class MinCostFlowSolver {
+private:
+    int nodeCount;
+    
+    // Edge list as added; each input edge becomes a forward/backward pair
+    struct InputEdge { int from, to, capacity; long long cost; };
+    vector<InputEdge> input;
+    
+    // CSR arrays
+    vector<int> firstEdge;          // node -> first edge, size nodeCount + 1
+    vector<int> edgeTo;
+    vector<int> edgeCapacity;       // residual capacity
+    vector<long long> edgeCost;
+    vector<int> edgeReverse;        // index of the paired edge
+    vector<int> forwardPosition;    // input edge id -> CSR index
+    
+    void build() {
+        firstEdge.assign(nodeCount + 1, 0);
+        for (const auto& e : input) {
+            firstEdge[e.from + 1]++;
+            firstEdge[e.to + 1]++;
+        }
+        for (int v = 0; v < nodeCount; v++) firstEdge[v + 1] += firstEdge[v];
+        
+        size_t total = input.size() * 2;
+        edgeTo.assign(total, 0);
+        edgeCapacity.assign(total, 0);
+        edgeCost.assign(total, 0);
+        edgeReverse.assign(total, 0);
+        forwardPosition.assign(input.size(), 0);
+        
+        vector<int> fill(firstEdge.begin(), firstEdge.end() - 1);
+        for (size_t i = 0; i < input.size(); i++) {
+            const auto& e = input[i];
+            int forward = fill[e.from]++;
+            int backward = fill[e.to]++;
+            edgeTo[forward] = e.to;
+            edgeCapacity[forward] = e.capacity;
+            edgeCost[forward] = e.cost;
+            edgeReverse[forward] = backward;
+            edgeTo[backward] = e.from;
+            edgeCapacity[backward] = 0;
+            edgeCost[backward] = -e.cost;
+            edgeReverse[backward] = forward;
+            forwardPosition[i] = forward;
+        }
+    }
+    
+public:
+    explicit MinCostFlowSolver(int nodes) : nodeCount(nodes) {}
+    
+    // Costs must be non-negative (true for every model built here)
+    int addEdge(int from, int to, int capacity, long long cost) {
+        input.push_back({from, to, capacity, cost});
+        return (int)input.size() - 1;
+    }
+    
+    // Min-cost maximum flow; returns (flow, cost). Each round runs one
+    // Dijkstra to update the potentials, then pushes a blocking flow
+    // (Dinic-style) through every zero reduced-cost path at once, so the
+    // number of shortest-path computations is the number of distinct path
+    // costs rather than the number of augmenting paths.
+    pair<long long, long long> solve(int source, int sink) {
+        build();
+        
+        const long long INF = numeric_limits<long long>::max() / 4;
+        vector<long long> potential(nodeCount, 0);
+        vector<long long> dist(nodeCount);
+        vector<int> level(nodeCount);
+        vector<int> currentEdge(nodeCount);
+        vector<int> bfsQueue(nodeCount);
+        long long totalFlow = 0, totalCost = 0;
+        
+        auto admissible = [&](int v, int e) {
+            return edgeCapacity[e] > 0 && 
+                   edgeCost[e] + potential[v] - potential[edgeTo[e]] == 0;
+        };
+        
+        // Depth-first push along admissible edges that go one level deeper
+        function<int(int, int)> push = [&](int v, int limit) -> int {
+            if (v == sink) return limit;
+            for (int& e = currentEdge[v]; e < firstEdge[v + 1]; e++) {
+                int w = edgeTo[e];
+                if (level[w] != level[v] + 1 || !admissible(v, e)) continue;
+                int pushed = push(w, min(limit, edgeCapacity[e]));
+                if (pushed > 0) {
+                    edgeCapacity[e] -= pushed;
+                    edgeCapacity[edgeReverse[e]] += pushed;
+                    totalCost += (long long)pushed * edgeCost[e];
+                    return pushed;
+                }
+            }
+            return 0;
+        };
+        
+        typedef pair<long long, int> Entry;
+        while (true) {
+            fill(dist.begin(), dist.end(), INF);
+            dist[source] = 0;
+            priority_queue<Entry, vector<Entry>, greater<Entry>> queue;
+            queue.push(Entry(0, source));
+            
+            while (!queue.empty()) {
+                Entry top = queue.top();
+                queue.pop();
+                int v = top.second;
+                if (top.first > dist[v]) continue;
+                for (int e = firstEdge[v]; e < firstEdge[v + 1]; e++) {
+                    if (edgeCapacity[e] == 0) continue;
+                    int w = edgeTo[e];
+                    long long candidate = dist[v] + edgeCost[e] + potential[v] - potential[w];
+                    if (candidate < dist[w]) {
+                        dist[w] = candidate;
+                        queue.push(Entry(candidate, w));
+                    }
+                }
+            }
+            if (dist[sink] == INF) break;
+            
+            for (int v = 0; v < nodeCount; v++) {
+                potential[v] += min(dist[v], dist[sink]);
+            }
+            
+            // Blocking flows on the admissible subgraph until the sink
+            // is cut off from the source at the current potentials
+            while (true) {
+                fill(level.begin(), level.end(), -1);
+                level[source] = 0;
+                int head = 0, tail = 0;
+                bfsQueue[tail++] = source;
+                while (head < tail) {
+                    int v = bfsQueue[head++];
+                    for (int e = firstEdge[v]; e < firstEdge[v + 1]; e++) {
+                        int w = edgeTo[e];
+                        if (level[w] < 0 && admissible(v, e)) {
+                            level[w] = level[v] + 1;
+                            bfsQueue[tail++] = w;
+                        }
+                    }
+                }
+                if (level[sink] < 0) break;
+                
+                for (int v = 0; v < nodeCount; v++) currentEdge[v] = firstEdge[v];
+                while (int pushed = push(source, numeric_limits<int>::max())) {
+                    totalFlow += pushed;
+                }
+            }
+        }
+        return make_pair(totalFlow, totalCost);
+    }
+    
+    // Flow carried by an input edge after solve()
+    int flowOn(int edgeId) const {
+        return edgeCapacity[edgeReverse[forwardPosition[edgeId]]];
+    }
+};
+
+// ==================== EARLIEST DEADLINE FIRST ====================
+// Walk the dated occurrences in time order and give each one to the pending
+// course whose exam comes soonest. A course whose exam day is reached drops
+// out, so nothing is ever placed on or after an exam. Each occurrence is
+// visited once and each course enters and leaves the heap once, plus once
+// per day on which it reaches a per-course cap: O((C + S) log C) without
+// limits.
+//
+// The allocator is a stepper: the caller feeds occurrences in time order,
+// asks whether any are wanted and lets it fill the ones it grants. That
+// lets a shared resource (e.g. cohort room seats) decide per occurrence.
+class DeadlineAllocator {
+private:
+    // (exam day, rank in priority order) - ties go to the higher priority
+    typedef pair<int, size_t> Deadline;
+    
+    const vector<shared_ptr<Course>>& activeCourses;
+    vector<int> remaining;
+    priority_queue<Deadline, vector<Deadline>, greater<Deadline>> pending;
+    vector<Deadline> capped;        // hit a per-course cap, back tomorrow
+    DailyLoad load;
+    int breakMinutes;
+    int minSessionMinutes;
+    int today;
+    
+public:
+    DeadlineAllocator(const vector<shared_ptr<Course>>& courses, const vector<int>& demandMinutes,
+                      int firstDay, const StudyLimits& limits = StudyLimits(), 
+                      int minSession = 30)
+        : activeCourses(courses), remaining(demandMinutes), load(limits, firstDay),
+          breakMinutes(limits.minBreakMinutes), minSessionMinutes(minSession), today(firstDay - 1) {
+        for (size_t i = 0; i < activeCourses.size(); i++) {
+            if (remaining[i] > 0) pending.push(Deadline(activeCourses[i]->getExamDay(), i));
+        }
+    }
+    
+    // Nothing left that could still be placed
+    bool finished() const { return pending.empty() && capped.empty(); }
+    
+    // Would any course use 'occ'? Occurrences must come in time order.
+    bool wants(const SlotOccurrence& occ) {
+        if (occ.day != today) {
+            for (const auto& entry : capped) pending.push(entry);
+            capped.clear();
+            today = occ.day;
+        }
+        // Exam reached - whatever is left stays unscheduled
+        while (!pending.empty() && pending.top().first <= occ.day) pending.pop();
+        return !pending.empty() && load.dayAllowance(occ.day) >= minSessionMinutes;
+    }
+    
+    // Book the occurrence for the most urgent courses; returns the minutes
+    // booked. Call after wants() said yes.
+    int fill(const SlotOccurrence& occ, Schedule& schedule) {
+        int booked = 0;
+        int cursor = occ.startMinute;
+        while (!pending.empty() && cursor < occ.endMinute) {
+            size_t course = pending.top().second;
+            if (pending.top().first <= occ.day) {
+                pending.pop();
+                continue;
+            }
+            if (load.dayAllowance(occ.day) < minSessionMinutes) break;
+            int allowance = load.allowance((uint32_t)course, occ.day);
+            if (allowance < min(remaining[course], minSessionMinutes)) {
+                capped.push_back(pending.top());
+                pending.pop();
+                continue;
+            }
+            
+            // Later sessions in the same slot keep the minimum break
+            int start = cursor > occ.startMinute ? cursor + breakMinutes : cursor;
+            int freeMinutes = occ.endMinute - start;
+            int minutes = min(min(freeMinutes, allowance), remaining[course]);
+            if (minutes < minSessionMinutes && minutes < remaining[course]) break;
+            
+            schedule.addSession(activeCourses[course], occ.day, start, minutes);
+            
+            cursor = start + minutes;
+            booked += minutes;
+            remaining[course] -= minutes;
+            load.add((uint32_t)course, occ.day, minutes);
+            if (remaining[course] == 0) pending.pop();
+        }
+        return booked;
+    }
+    
+    // Whole horizon in one go. Returns the minutes booked.
+    static long long allocate(const vector<shared_ptr<Course>>& activeCourses,
+                              const vector<int>& demandMinutes,
+                              const SlotHorizon& horizon, Schedule& schedule,
+                              const StudyLimits& limits = StudyLimits()) {
+        DeadlineAllocator allocator(activeCourses, demandMinutes, horizon.getStartDay(), limits);
+        long long bookedMinutes = 0;
+        for (SlotOccurrence occ : horizon) {
+            if (allocator.finished()) break;
+            if (allocator.wants(occ)) bookedMinutes += allocator.fill(occ, schedule);
+        }
+        return bookedMinutes;
+    }
+};
+
+// ==================== ROLLING HORIZON PLANNER ====================
+// Study time set aside for one course in one future week
+struct CapacityReservation {
+    int weekStart;          // Calendar day number of the Monday
+    uint32_t course;        // index into the planner's course list
+    int minutes;
+};
+
+// Only the next 'windowDays' days get real sessions. Beyond the window
+// each course just holds a number of minutes per week, assigned earliest
+// deadline first over week/exam-day segments, so the stored plan is
+// O(window sessions + weeks + courses) however long the semester is.
+// advanceTo() drops the days that have passed and books only the days that
+// newly enter the window; reservations are recomputed in O((W + C) log C).
+class RollingHorizonPlanner {
+private:
+    vector<shared_ptr<Course>> activeCourses;   // priority order
+    vector<TimeSlot> weeklySlots;
+    StudyLimits limits;
+    int windowDays;
+    int windowStart;
+    int windowEnd;
+    int lastExam;
+    
+    Schedule window;                // sessions on [windowStart, windowEnd)
+    long long windowBookedMinutes;
+    vector<CapacityReservation> reservations;
+    vector<int> reservedMinutes;    // per course, beyond the window
+    
+    vector<int> windowMinutesPerCourse() const {
+        vector<int> minutes(activeCourses.size(), 0);
+        vector<int> position = window.positionsIn(activeCourses);
+        for (const auto& session : window.getSessions()) {
+            minutes[position[session.course]] += session.getDurationMinutes();
+        }
+        return minutes;
+    }
+    
+    // Book real sessions on [fromDay, toDay) for whatever the window does
+    // not cover yet
+    void bookDays(int fromDay, int toDay) {
+        if (fromDay >= toDay) return;
+        
+        vector<int> planned = windowMinutesPerCourse();
+        vector<int> demand(activeCourses.size());
+        for (size_t i = 0; i < activeCourses.size(); i++) {
+            demand[i] = max(0, activeCourses[i]->getRemainingHours() * 60 - planned[i]);
+        }
+        SlotHorizon days(weeklySlots, fromDay, toDay);
+        windowBookedMinutes += DeadlineAllocator::allocate(activeCourses, demand, days, window, limits);
+    }
+    
+    // Spread what the window leaves over [windowEnd, lastExam). The far
+    // future is cut at every Monday and every exam day; courses in exam
+    // order take the earliest segments with capacity left before their exam.
+    void reserveBeyondWindow() {
+        reservations.clear();
+        reservedMinutes.assign(activeCourses.size(), 0);
+        if (windowEnd >= lastExam) return;
+        
+        SlotHorizon far(weeklySlots, windowEnd, lastExam);
+        vector<int> cuts;
+        cuts.push_back(windowEnd);
+        for (int monday = windowEnd - Calendar::weekday(windowEnd) + 7; monday < lastExam; monday += 7) {
+            cuts.push_back(monday);
+        }
+        vector<size_t> byExam;
+        for (size_t i = 0; i < activeCourses.size(); i++) {
+            int exam = activeCourses[i]->getExamDay();
+            if (exam > windowEnd) {
+                cuts.push_back(exam);
+                byExam.push_back(i);
+            }
+        }
+        cuts.push_back(lastExam);
+        sort(cuts.begin(), cuts.end());
+        cuts.erase(unique(cuts.begin(), cuts.end()), cuts.end());
+        stable_sort(byExam.begin(), byExam.end(), [&](size_t a, size_t b) {
+            return activeCourses[a]->getExamDay() < activeCourses[b]->getExamDay();
+        });
+        
+        // Free minutes per segment [cuts[s], cuts[s + 1]), within the daily cap
+        vector<long long> freeMinutes(cuts.size() - 1);
+        for (size_t s = 0; s + 1 < cuts.size(); s++) {
+            freeMinutes[s] = limits.capCapacity(far.capacityBefore(cuts[s + 1]) - far.capacityBefore(cuts[s]),
+                                                cuts[s + 1] - cuts[s]);
+        }
+        
+        vector<int> planned = windowMinutesPerCourse();
+        size_t first = 0;   // segments before this one are full
+        for (size_t course : byExam) {
+            int exam = activeCourses[course]->getExamDay();
+            int demand = activeCourses[course]->getRemainingHours() * 60 - planned[course];
+            for (size_t s = first; demand > 0 && s + 1 < cuts.size() && cuts[s + 1] <= exam; s++) {
+                int minutes = (int)min<long long>(freeMinutes[s], demand);
+                if (minutes == 0) continue;
+                freeMinutes[s] -= minutes;
+                demand -= minutes;
+                reservedMinutes[course] += minutes;
+                
+                int monday = cuts[s] - Calendar::weekday(cuts[s]);
+                if (!reservations.empty() && reservations.back().weekStart == monday &&
+                    reservations.back().course == course) {
+                    reservations.back().minutes += minutes;
+                } else {
+                    reservations.push_back(CapacityReservation{monday, (uint32_t)course, minutes});
+                }
+            }
+            while (first < freeMinutes.size() && freeMinutes[first] == 0) first++;
+        }
+        stable_sort(reservations.begin(), reservations.end(),
+                    [](const CapacityReservation& a, const CapacityReservation& b) {
+                        return a.weekStart < b.weekStart;
+                    });
+    }
+    
+    void refreshReport() {
+        SlotHorizon days(weeklySlots, windowStart, windowEnd);
+        window.setUtilization(windowBookedMinutes, days.capacityBefore(windowEnd));
+        
+        vector<int> planned = windowMinutesPerCourse();
+        vector<CourseFeasibility> report;
+        report.reserve(activeCourses.size());
+        for (size_t i = 0; i < activeCourses.size(); i++) {
+            CourseFeasibility entry;
+            entry.courseName = activeCourses[i]->getName();
+            entry.examDay = activeCourses[i]->getExamDay();
+            entry.requiredMinutes = activeCourses[i]->getRemainingHours() * 60;
+            entry.scheduledMinutes = planned[i] + reservedMinutes[i];
+            report.push_back(entry);
+        }
+        window.setFeasibilityReport(report);
+    }
+    
+public:
+    RollingHorizonPlanner(const vector<shared_ptr<Course>>& active, const vector<TimeSlot>& slots,
+                          int days, int startDay, const StudyLimits& studyLimits = StudyLimits())
+        : activeCourses(active), weeklySlots(slots), limits(studyLimits), windowDays(max(1, days)),
+          windowStart(startDay), windowEnd(startDay + max(1, days)), lastExam(startDay),
+          window("Study Plan (Rolling Window)"), windowBookedMinutes(0) {
+        for (const auto& course : activeCourses) {
+            lastExam = max(lastExam, course->getExamDay());
+        }
+        bookDays(windowStart, windowEnd);
+        reserveBeyondWindow();
+        refreshReport();
+    }
+    
+    // Slide the window forward to start at 'day'. Sessions already booked
+    // for days still in the window are kept; only new days are planned.
+    // Reservations always follow the courses' current progress.
+    void advanceTo(int day) {
+        if (day < windowStart) return;
+        
+        Schedule kept(window);
+        window = Schedule("Study Plan (Rolling Window)");
+        windowBookedMinutes = 0;
+        for (const auto& session : kept.getSessions()) {
+            if (session.getDate() >= day) {
+                window.addSession(kept, session);
+                windowBookedMinutes += session.getDurationMinutes();
+            }
+        }
+        
+        int newEnd = day + windowDays;
+        bookDays(max(day, windowEnd), newEnd);
+        windowStart = day;
+        windowEnd = newEnd;
+        reserveBeyondWindow();
+        refreshReport();
+    }
+    
+    int getWindowStart() const { return windowStart; }
+    int getWindowEnd() const { return windowEnd; }
+    const Schedule& getWindowSchedule() const { return window; }
+    const vector<CapacityReservation>& getReservations() const { return reservations; }
+    
+    void displayReservations() const {
+        if (reservations.empty()) return;
+        
+        cout << "\nReserved study time after " << Calendar::formatIsoDate(windowEnd - 1) 
+             << " (sessions are booked as the window reaches it):" << endl;
+        for (size_t i = 0; i < reservations.size(); ) {
+            int week = reservations[i].weekStart;
+            cout << "  Week of " << Calendar::formatIsoDate(week) << ":";
+            for (; i < reservations.size() && reservations[i].weekStart == week; i++) {
+                cout << " " << activeCourses[reservations[i].course]->getName() << " "
+                     << TimeSlot::formatHours(reservations[i].minutes) << "h"
+                     << (i + 1 < reservations.size() && reservations[i + 1].weekStart == week ? "," : "");
+            }
+            cout << endl;
+        }
+    }
+};
+
+// ==================== INDEXED PRIORITY HEAP ====================
+// Max-heap of item ids (course indices) keyed by priority. The position
+// table lets a single key change be repaired in O(log n) instead of
+// re-sorting everything; a 4-ary layout keeps the tree shallow and the
+// children of a node next to each other in memory.
+class IndexedPriorityHeap {
+private:
+    static constexpr size_t ARITY = 4;
+    static constexpr size_t NOT_IN_HEAP = (size_t)-1;
+
+    vector<size_t> heap;       // heap position -> item id
+    vector<size_t> position;   // item id -> heap position
+    vector<double> keys;       // item id -> key
+
+    // Higher key wins; ties go to the lower id so ordering is deterministic
+    bool before(size_t a, size_t b) const {
+        if (keys[a] != keys[b]) return keys[a] > keys[b];
+        return a < b;
+    }
+
+    void place(size_t pos, size_t id) {
+        heap[pos] = id;
+        position[id] = pos;
+    }
+
+    void siftUp(size_t pos) {
+        size_t id = heap[pos];
+        while (pos > 0) {
+            size_t parent = (pos - 1) / ARITY;
+            if (!before(id, heap[parent])) break;
+            place(pos, heap[parent]);
+            pos = parent;
+        }
+        place(pos, id);
+    }
+
+    void siftDown(size_t pos) {
+        size_t id = heap[pos];
+        size_t n = heap.size();
+        while (true) {
+            size_t first = pos * ARITY + 1;
+            if (first >= n) break;
+            size_t last = min(first + ARITY, n);
+            size_t best = first;
+            for (size_t c = first + 1; c < last; c++) {
+                if (before(heap[c], heap[best])) best = c;
+            }
+            if (!before(heap[best], id)) break;
+            place(pos, heap[best]);
+            pos = best;
+        }
+        place(pos, id);
+    }
+
+public:
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+
+    bool contains(size_t id) const {
+        return id < position.size() && position[id] != NOT_IN_HEAP;
+    }
+
+    // O(1) - the item with the highest key
+    size_t top() const { return heap.front(); }
+    double topKey() const { return keys[heap.front()]; }
+
+    void push(size_t id, double key) {
+        if (contains(id)) {
+            update(id, key);
+            return;
+        }
+        if (id >= position.size()) {
+            position.resize(id + 1, NOT_IN_HEAP);
+            keys.resize(id + 1, 0.0);
+        }
+        keys[id] = key;
+        heap.push_back(id);
+        siftUp(heap.size() - 1);
+    }
+
+    // Increase-key or decrease-key in O(log n)
+    void update(size_t id, double key) {
+        if (!contains(id)) {
+            push(id, key);
+            return;
+        }
+        double old = keys[id];
+        keys[id] = key;
+        if (key > old) siftUp(position[id]);
+        else siftDown(position[id]);
+    }
+
+    void remove(size_t id) {
+        if (!contains(id)) return;
+        size_t pos = position[id];
+        size_t last = heap.back();
+        heap.pop_back();
+        position[id] = NOT_IN_HEAP;
+        if (pos < heap.size()) {
+            place(pos, last);
+            siftUp(pos);
+            siftDown(position[last]);
+        }
+    }
+
+    size_t pop() {
+        size_t id = top();
+        remove(id);
+        return id;
+    }
+
+    // Ids in descending key order, stopping after 'limit' items. Works on a
+    // copy so the live heap is untouched: O(n + limit * log n).
+    vector<size_t> orderedItems(size_t limit = (size_t)-1) const {
+        IndexedPriorityHeap copy(*this);
+        vector<size_t> result;
+        result.reserve(min(limit, copy.size()));
+        while (!copy.empty() && result.size() < limit) {
+            result.push_back(copy.pop());
+        }
+        return result;
+    }
+};
+
+// ==================== COHORT SCHEDULER ====================
+// One student of a department plan
+struct CohortStudent {
+    string name;
+    vector<shared_ptr<Course>> courses;
+    vector<uint32_t> roomSlots;     // room slots the student can attend, empty = all
+};
+
+struct CohortResult {
+    vector<Schedule> schedules;     // one per student, in the order added
+    long long demandMinutes;
+    long long bookedMinutes;
+    long long seatsUsed;            // student-occurrences given a room seat
+    long long seatsOffered;
+    double lowestCoverage;          // worst-served student, 0..1
+    double milliseconds;
+    
+    void display() const {
+        cout << "\n=== Cohort Plan ===" << endl;
+        cout << "Students: " << schedules.size() << endl;
+        cout << "Study hours: " << fixed << setprecision(1) << bookedMinutes / 60.0 << " of "
+             << demandMinutes / 60.0 << " needed" << endl;
+        cout << "Room seats used: " << seatsUsed << " of " << seatsOffered << endl;
+        cout << "Lowest student coverage: " << fixed << setprecision(1) << lowestCoverage * 100 << "%" << endl;
+        cout << "Planned in " << setprecision(2) << milliseconds << " ms" << endl;
+    }
+};
+
+// Plans many students at once against study rooms shared per time slot.
+// Every student runs their own earliest-deadline-first planner over the
+// room slots; a student studies in an occurrence only after winning one
+// of its seats, and seats are plain atomic counters, so planners on
+// different threads never wait on each other.
+//
+// FIRST_COME lets every worker race through its students - fastest, but
+// who wins a contested seat depends on thread timing. FAIR_SHARE walks the
+// calendar one occurrence at a time: the planners decide in parallel who
+// wants it, seats go to the least-served students (booked / needed, ties
+// by position) and the winners fill it in parallel. The result is the same
+// for any number of threads.
+class CohortScheduler {
+public:
+    enum Mode { FIRST_COME, FAIR_SHARE };
+    
+private:
+    vector<TimeSlot> roomSlots;
+    vector<int> roomsPerSlot;
+    vector<CohortStudent> students;
+    StudyLimits limits;
+    int startDay;
+    size_t workers;         // ranges planned in parallel, 0 = one per pool worker
+    
+    // Per-student planning state
+    struct Planner {
+        vector<shared_ptr<Course>> courses;     // priority order
+        vector<bool> canAttend;                 // by room slot index
+        DeadlineAllocator allocator;
+        Schedule schedule;
+        long long demand;
+        long long booked;
+        
+        Planner(const vector<shared_ptr<Course>>& ordered, const vector<int>& demands,
+                vector<bool> attend, int firstDay, const StudyLimits& limits, const string& name)
+            : courses(ordered), canAttend(move(attend)), 
+              allocator(courses, demands, firstDay, limits),
+              schedule("Study Schedule - " + name), demand(0), booked(0) {
+            for (int minutes : demands) demand += minutes;
+        }
+        
+        bool wants(const SlotOccurrence& occ) {
+            return !allocator.finished() && canAttend[occ.slotIndex] && allocator.wants(occ);
+        }
+    };
+    
+    static bool takeSeat(atomic<int>& seats) {
+        int left = seats.load(memory_order_relaxed);
+        while (left > 0) {
+            if (seats.compare_exchange_weak(left, left - 1, memory_order_acq_rel)) return true;
+        }
+        return false;
+    }
+    
+    unique_ptr<Planner> makePlanner(const CohortStudent& student) const {
+        vector<shared_ptr<Course>> ordered;
+        for (const auto& course : student.courses) {
+            if (course->getRemainingHours() > 0 && course->getExamDay() > startDay) ordered.push_back(course);
+        }
+        stable_sort(ordered.begin(), ordered.end(), 
+                    [](const shared_ptr<Course>& a, const shared_ptr<Course>& b) {
+                        return a->getPriority() > b->getPriority();
+                    });
+        vector<int> demands;
+        for (const auto& course : ordered) demands.push_back(course->getRemainingHours() * 60);
+        
+        vector<bool> attend(roomSlots.size(), student.roomSlots.empty());
+        for (uint32_t slot : student.roomSlots) {
+            if (slot < attend.size()) attend[slot] = true;
+        }
+        // The allocator keeps a reference to the course list, so the
+        // planner is heap-allocated and never moved
+        unique_ptr<Planner> planner(new Planner(ordered, demands, move(attend), startDay, limits, student.name));
+        return planner;
+    }
+    
+    // Split [0, n) into one contiguous range per worker and run 'work' on
+    // each; with a single worker it runs on the calling thread
+    template <typename Fn>
+    void forEachRange(size_t n, Fn work) const {
+        size_t parts = workers > 0 ? workers : ThreadPool::shared().size();
+        if (parts == 1) {
+            work((size_t)0, n);
+            return;
+        }
+        size_t chunk = max<size_t>(1, (n + parts - 1) / parts);
+        vector<future<void>> running;
+        for (size_t begin = 0; begin < n; begin += chunk) {
+            size_t end = min(n, begin + chunk);
+            running.push_back(ThreadPool::shared().submit([&work, begin, end] { work(begin, end); }));
+        }
+        for (auto& task : running) ThreadPool::shared().wait(task);
+    }
+    
+public:
+    CohortScheduler(int firstDay) : startDay(firstDay), workers(0) {}
+    
+    void addRoomSlot(const TimeSlot& slot, int rooms) {
+        roomSlots.push_back(slot);
+        roomsPerSlot.push_back(max(0, rooms));
+    }
+    
+    void addStudent(const CohortStudent& student) { students.push_back(student); }
+    void setStudyLimits(const StudyLimits& studyLimits) { limits = studyLimits; }
+    void setWorkerCount(size_t count) { workers = count; }
+    size_t studentCount() const { return students.size(); }
+    
+    CohortResult schedule(Mode mode) const {
+        auto wallStart = chrono::steady_clock::now();
+        int lastExam = startDay;
+        for (const auto& student : students) {
+            for (const auto& course : student.courses) lastExam = max(lastExam, course->getExamDay());
+        }
+        SlotHorizon horizon(roomSlots, startDay, lastExam);
+        
+        // Room seats per occurrence - the only state planners share
+        unique_ptr<atomic<int>[]> seats(new atomic<int>[horizon.size()]);
+        long long seatsOffered = 0;
+        vector<long long> slotMinutes(roomSlots.size(), 0);   // over the horizon, rooms only
+        for (uint32_t id = 0; id < horizon.size(); id++) {
+            SlotOccurrence occ = horizon.at(id);
+            seats[id].store(roomsPerSlot[occ.slotIndex], memory_order_relaxed);
+            seatsOffered += roomsPerSlot[occ.slotIndex];
+            if (roomsPerSlot[occ.slotIndex] > 0) slotMinutes[occ.slotIndex] += occ.getDurationMinutes();
+        }
+        
+        vector<unique_ptr<Planner>> planners(students.size());
+        forEachRange(students.size(), [&](size_t begin, size_t end) {
+            for (size_t s = begin; s < end; s++) planners[s] = makePlanner(students[s]);
+        });
+        
+        if (mode == FIRST_COME) {
+            forEachRange(planners.size(), [&](size_t begin, size_t end) {
+                for (size_t s = begin; s < end; s++) {
+                    Planner& planner = *planners[s];
+                    for (SlotOccurrence occ : horizon) {
+                        if (planner.allocator.finished()) break;
+                        if (!planner.wants(occ) || !takeSeat(seats[occ.id])) continue;
+                        int minutes = planner.allocator.fill(occ, planner.schedule);
+                        planner.booked += minutes;
+                        // Nothing fit after all - give the seat back
+                        if (minutes == 0) seats[occ.id].fetch_add(1, memory_order_acq_rel);
+                    }
+                }
+            });
+        } else {
+            // One parallel pass per occurrence: the winners of the previous
+            // occurrence fill it, then everyone says whether they want this one
+            vector<char> wanted(planners.size(), 0);
+            vector<char> granted(planners.size(), 0);
+            vector<uint32_t> requests;
+            SlotOccurrence previous = {};
+            for (uint32_t id = 0; id <= horizon.size(); id++) {
+                bool last = id == horizon.size();
+                SlotOccurrence occ = last ? SlotOccurrence() : horizon.at(id);
+                forEachRange(planners.size(), [&](size_t begin, size_t end) {
+                    for (size_t s = begin; s < end; s++) {
+                        Planner& planner = *planners[s];
+                        if (granted[s]) {
+                            int minutes = planner.allocator.fill(previous, planner.schedule);
+                            planner.booked += minutes;
+                            if (minutes == 0) seats[previous.id].fetch_add(1, memory_order_relaxed);
+                            granted[s] = 0;
+                        }
+                        wanted[s] = !last && planner.wants(occ);
+                    }
+                });
+                if (last) break;
+                
+                requests.clear();
+                for (uint32_t s = 0; s < planners.size(); s++) {
+                    if (wanted[s]) requests.push_back(s);
+                }
+                int capacity = seats[id].load(memory_order_relaxed);
+                if ((int)requests.size() > capacity) {
+                    // Least-served first: booked_a / demand_a < booked_b / demand_b
+                    auto lessServed = [&](uint32_t a, uint32_t b) {
+                        long long left = planners[a]->booked * max(1LL, planners[b]->demand);
+                        long long right = planners[b]->booked * max(1LL, planners[a]->demand);
+                        return left != right ? left < right : a < b;
+                    };
+                    nth_element(requests.begin(), requests.begin() + capacity, requests.end(), lessServed);
+                    requests.resize(capacity);
+                }
+                for (uint32_t s : requests) granted[s] = 1;
+                seats[id].fetch_sub((int)requests.size(), memory_order_relaxed);
+                previous = occ;
+            }
+        }
+        
+        CohortResult result;
+        result.demandMinutes = 0;
+        result.bookedMinutes = 0;
+        result.seatsOffered = seatsOffered;
+        result.seatsUsed = seatsOffered;
+        result.lowestCoverage = 1.0;
+        for (uint32_t id = 0; id < horizon.size(); id++) result.seatsUsed -= seats[id].load();
+        for (auto& planner : planners) {
+            result.demandMinutes += planner->demand;
+            result.bookedMinutes += planner->booked;
+            if (planner->demand > 0) {
+                result.lowestCoverage = min(result.lowestCoverage, (double)planner->booked / planner->demand);
+            }
+            long long capacity = 0;
+            for (size_t slot = 0; slot < roomSlots.size(); slot++) {
+                if (planner->canAttend[slot]) capacity += slotMinutes[slot];
+            }
+            planner->schedule.setUtilization(planner->booked, capacity);
+            result.schedules.push_back(move(planner->schedule));
+        }
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - wallStart;
+        result.milliseconds = elapsed.count();
+        return result;
+    }
+};
+
+// ==================== PREREQUISITE GRAPH ====================
+// "Study X before Y" edges between courses, kept acyclic: an edge that
+// would close a cycle is refused when it is added (one O(V + E) search),
+// so every later ordering is guaranteed to exist.
+class PrerequisiteGraph {
+private:
+    vector<vector<uint32_t>> successors;      // course -> courses that need it
+    vector<vector<uint32_t>> predecessors;    // course -> courses it needs
+    size_t edgeCount;
+    
+    // Is 'to' reachable from 'from' along successor edges?
+    bool reaches(uint32_t from, uint32_t to) const {
+        vector<bool> seen(successors.size(), false);
+        vector<uint32_t> stack(1, from);
+        seen[from] = true;
+        while (!stack.empty()) {
+            uint32_t node = stack.back();
+            stack.pop_back();
+            if (node == to) return true;
+            for (uint32_t next : successors[node]) {
+                if (!seen[next]) {
+                    seen[next] = true;
+                    stack.push_back(next);
+                }
+            }
+        }
+        return false;
+    }
+    
+    // Kahn's algorithm on one component; among ready courses the one the
+    // caller ranked first goes first
+    static vector<uint32_t> orderComponent(const vector<vector<uint32_t>>& prerequisites,
+                                           const vector<vector<uint32_t>>& dependents,
+                                           const vector<uint32_t>& rank,
+                                           const vector<uint32_t>& members) {
+        typedef pair<uint32_t, uint32_t> Ready;   // (rank, node)
+        priority_queue<Ready, vector<Ready>, greater<Ready>> ready;
+        unordered_map<uint32_t, uint32_t> waiting;
+        for (uint32_t node : members) {
+            waiting[node] = (uint32_t)prerequisites[node].size();
+            if (prerequisites[node].empty()) ready.push(Ready(rank[node], node));
+        }
+        
+        vector<uint32_t> order;
+        order.reserve(members.size());
+        while (!ready.empty()) {
+            uint32_t node = ready.top().second;
+            ready.pop();
+            order.push_back(node);
+            for (uint32_t next : dependents[node]) {
+                if (--waiting[next] == 0) ready.push(Ready(rank[next], next));
+            }
+        }
+        return order;
+    }
+    
+public:
+    PrerequisiteGraph() : edgeCount(0) {}
+    
+    void addNode() {
+        successors.emplace_back();
+        predecessors.emplace_back();
+    }
+    
+    void reserve(size_t nodes) {
+        successors.reserve(nodes);
+        predecessors.reserve(nodes);
+    }
+    
+    size_t size() const { return successors.size(); }
+    bool hasEdges() const { return edgeCount > 0; }
+    
+    // Record that 'before' must be studied before 'after'. Returns false
+    // (and changes nothing) if that would create a cycle.
+    bool addEdge(uint32_t before, uint32_t after) {
+        if (before == after || reaches(after, before)) return false;
+        if (find(successors[before].begin(), successors[before].end(), after) != successors[before].end()) {
+            return true;
+        }
+        successors[before].push_back(after);
+        predecessors[after].push_back(before);
+        edgeCount++;
+        return true;
+    }
+    
+    const vector<uint32_t>& prerequisitesOf(uint32_t course) const { return predecessors[course]; }
+    
+    // Topological order of nodes 0..n-1 of an acyclic graph given as
+    // prerequisite lists, as close to 'preferred' as the edges allow.
+    // Weakly connected components don't constrain each other, so each is
+    // sorted on its own - on the thread pool when the graph is large - and
+    // the results are merged by rank, which gives the same order as one
+    // global pass.
+    static vector<uint32_t> schedulingOrder(const vector<vector<uint32_t>>& prerequisites,
+                                            const vector<uint32_t>& preferred) {
+        const size_t parallelThreshold = 512;
+        size_t n = prerequisites.size();
+        vector<uint32_t> rank(n);
+        for (uint32_t i = 0; i < preferred.size(); i++) rank[preferred[i]] = i;
+        
+        // Components with union-find, dependents by inverting the lists
+        vector<uint32_t> parent(n);
+        for (uint32_t i = 0; i < n; i++) parent[i] = i;
+        auto root = [&](uint32_t x) {
+            while (parent[x] != x) x = parent[x] = parent[parent[x]];
+            return x;
+        };
+        vector<vector<uint32_t>> dependents(n);
+        for (uint32_t node = 0; node < n; node++) {
+            for (uint32_t before : prerequisites[node]) {
+                dependents[before].push_back(node);
+                parent[root(before)] = root(node);
+            }
+        }
+        map<uint32_t, vector<uint32_t>> byRoot;
+        for (uint32_t node : preferred) byRoot[root(node)].push_back(node);
+        
+        vector<vector<uint32_t>> orders;
+        if (n >= parallelThreshold && byRoot.size() > 1) {
+            vector<future<vector<uint32_t>>> pending;
+            for (const auto& component : byRoot) {
+                const vector<uint32_t>* members = &component.second;
+                pending.push_back(ThreadPool::shared().submit([&, members] {
+                    return orderComponent(prerequisites, dependents, rank, *members);
+                }));
+            }
+            // Often called from a pool task (compareStrategies), so wait by
+            // helping rather than blocking a worker
+            for (auto& task : pending) orders.push_back(ThreadPool::shared().wait(task));
+        } else {
+            for (const auto& component : byRoot) {
+                orders.push_back(orderComponent(prerequisites, dependents, rank, component.second));
+            }
+        }
+        
+        // k-way merge of the component orders by rank
+        typedef pair<uint32_t, size_t> Head;      // (rank, component)
+        priority_queue<Head, vector<Head>, greater<Head>> heads;
+        vector<size_t> next(orders.size(), 0);
+        for (size_t c = 0; c < orders.size(); c++) {
+            if (!orders[c].empty()) heads.push(Head(rank[orders[c][0]], c));
+        }
+        vector<uint32_t> merged;
+        merged.reserve(n);
+        while (!heads.empty()) {
+            size_t c = heads.top().second;
+            heads.pop();
+            merged.push_back(orders[c][next[c]++]);
+            if (next[c] < orders[c].size()) heads.push(Head(rank[orders[c][next[c]]], c));
+        }
+        return merged;
+    }
+};
+
+// ==================== COURSE NAME TABLE ====================
+// Course name -> position in a course list, as an open-addressing table of
+// 64-bit words (32-bit name hash << 32 | position + 1; 0 = empty). Names are
+// compared through the course list, so the table holds no strings and an
+// insert allocates nothing except when the table doubles.
+class CourseNameTable {
+private:
+    vector<uint64_t> slots;
+    size_t mask;
+    size_t used;
+    
+    static uint32_t hashOf(string_view name) {
+        size_t h = hash<string_view>()(name);
+        return (uint32_t)(h ^ (h >> 32));
+    }
+    
+    // Rebuild with room for 'count' names at no more than half load
+    void resize(size_t count) {
+        size_t capacity = 16;
+        while (capacity < count * 2) capacity <<= 1;
+        vector<uint64_t> old(capacity, 0);
+        old.swap(slots);
+        mask = capacity - 1;
+        for (uint64_t word : old) {
+            if (!word) continue;
+            size_t i = (word >> 32) & mask;
+            while (slots[i]) i = (i + 1) & mask;
+            slots[i] = word;
+        }
+    }
+    
+public:
+    CourseNameTable() : slots(16, 0), mask(15), used(0) {}
+    
+    void reserve(size_t count) {
+        if (count * 2 > slots.size()) resize(count);
+    }
+    
+    // Position of the course named 'name', or -1
+    int find(string_view name, const vector<shared_ptr<Course>>& courses) const {
+        uint32_t h = hashOf(name);
+        for (size_t i = h & mask; slots[i]; i = (i + 1) & mask) {
+            uint64_t word = slots[i];
+            if ((uint32_t)(word >> 32) == h && courses[(uint32_t)word - 1]->getName() == name) {
+                return (int)((uint32_t)word - 1);
+            }
+        }
+        return -1;
+    }
+    
+    // Map courses[position]'s name to 'position'; false if the name is taken
+    bool insert(size_t position, const vector<shared_ptr<Course>>& courses) {
+        if ((used + 1) * 2 > slots.size()) resize(used + 1);
+        string_view name = courses[position]->getName();
+        uint32_t h = hashOf(name);
+        size_t i = h & mask;
+        for (; slots[i]; i = (i + 1) & mask) {
+            uint64_t word = slots[i];
+            if ((uint32_t)(word >> 32) == h && courses[(uint32_t)word - 1]->getName() == name) return false;
+        }
+        slots[i] = ((uint64_t)h << 32) | (uint32_t)(position + 1);
+        used++;
+        return true;
+    }
+};
+
+// ==================== COURSE IMPORT ====================
+// Read-only view of a whole file: memory-mapped where the platform allows,
+// otherwise (or for an empty or unmappable file) read into a buffer.
+class MappedFile {
+private:
+    const char* mapped;
+    size_t mappedSize;
+    vector<char> fallback;
+    bool opened;
+    
+public:
+    explicit MappedFile(const string& filename) : mapped(nullptr), mappedSize(0), opened(false) {
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct stat info;
+            if (fstat(fd, &info) == 0 && info.st_size > 0) {
+                void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (view != MAP_FAILED) {
+                    madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+                    mapped = (const char*)view;
+                    mappedSize = (size_t)info.st_size;
+                }
+            }
+            ::close(fd);
+            opened = true;
+            if (mapped) return;
+        }
+#endif
+        ifstream file(filename, ios::binary);
+        if (!file.is_open()) return;
+        opened = true;
+        fallback.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    }
+    
+    ~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mapped) munmap((void*)mapped, mappedSize);
+#endif
+    }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    bool isOpen() const { return opened; }
+    string_view data() const {
+        return mapped ? string_view(mapped, mappedSize) : string_view(fallback.data(), fallback.size());
+    }
+};
+
+// Splits CSV course records (Course::serialize lines) into their five
+// fields in one pass. Newlines and commas are found 16 bytes at a time
+// with SSE2 when available. Only the last four commas of a line delimit
+// fields, so course names may contain commas.
+class CourseRecordScanner {
+public:
+    // onRecord(line, field) for each well-formed line, onError(line,
+    // message) for the rest; blank lines are skipped. Lines count from 1.
+    template <typename OnRecord, typename OnError>
+    static void scan(string_view text, OnRecord onRecord, OnError onError) {
+        const char* data = text.data();
+        size_t size = text.size();
+        size_t lineStart = 0, line = 0;
+        size_t commas[4];
+        size_t commaCount = 0;
+        
+        auto endLine = [&](size_t end) {
+            line++;
+            if (end > lineStart && data[end - 1] == '\r') end--;
+            if (end > lineStart) {
+                if (commaCount < 4) {
+                    onError(line, "Expected 5 comma-separated fields");
+                } else {
+                    // Oldest to newest of the last four commas
+                    size_t c[4];
+                    for (int k = 0; k < 4; k++) c[k] = commas[(commaCount + k) & 3];
+                    const string_view field[5] = {
+                        string_view(data + lineStart, c[0] - lineStart),
+                        string_view(data + c[0] + 1, c[1] - c[0] - 1),
+                        string_view(data + c[1] + 1, c[2] - c[1] - 1),
+                        string_view(data + c[2] + 1, c[3] - c[2] - 1),
+                        string_view(data + c[3] + 1, end - c[3] - 1)
+                    };
+                    onRecord(line, field);
+                }
+            }
+            commaCount = 0;
+        };
+        auto delimiter = [&](size_t at) {
+            if (data[at] == ',') {
+                commas[commaCount++ & 3] = at;
+            } else {
+                endLine(at);
+                lineStart = at + 1;
+            }
+        };
+        
+        size_t i = 0;
+#if defined(__SSE2__)
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i comma = _mm_set1_epi8(',');
+        for (; i + 16 <= size; i += 16) {
+            __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+            unsigned mask = (unsigned)_mm_movemask_epi8(
+                _mm_or_si128(_mm_cmpeq_epi8(block, newline), _mm_cmpeq_epi8(block, comma)));
+            while (mask) {
+                delimiter(i + __builtin_ctz(mask));
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; i < size; i++) {
+            if (data[i] == '\n' || data[i] == ',') delimiter(i);
+        }
+        if (lineStart < size) endLine(size);
+    }
+};
+
+struct ImportError {
+    size_t line;
+    string message;
+};
+
+struct ImportReport {
+    size_t imported = 0;
+    vector<ImportError> errors;
+    double elapsedMs = 0;
+    
+    void display(size_t maxErrors = 10) const {
+        cout << "Imported " << imported << " courses in " << fixed << setprecision(1) 
+             << elapsedMs << " ms" << endl;
+        if (errors.empty()) return;
+        cout << errors.size() << " lines skipped:" << endl;
+        for (size_t i = 0; i < errors.size() && i < maxErrors; i++) {
+            cout << "  Line " << errors[i].line << ": " << errors[i].message << endl;
+        }
+        if (errors.size() > maxErrors) {
+            cout << "  ... and " << errors.size() - maxErrors << " more" << endl;
+        }
+    }
+};
+
+// ==================== SCHEDULE OPTIMIZER CLASS (MAIN LOGIC) ====================
+class ScheduleOptimizer {
+private:
+    vector<shared_ptr<Course>> courses;
+    // Merged, non-overlapping weekly slots
+    SlotIndex availableSlots;
+
+    // Active courses (hours remaining, exam still ahead) ordered by priority
+    IndexedPriorityHeap courseQueue;
+    // Hour totals over all courses, adjusted on every add and progress event
+    long long totalHoursNeeded;
+    long long totalHoursCompleted;
+    AvailabilityBitmap weeklyAvailability;
+    CourseNameTable courseIndexByName;
+    
+    // Schedule kept up to date as courses and slots change (see trackSchedule)
+    unique_ptr<IncrementalScheduler> liveSchedule;
+    
+    // "Study X before Y" edges by course index
+    PrerequisiteGraph prerequisites;
+    
+    // Near-window plan of ROLLING_WINDOW mode, slid forward on each run
+    unique_ptr<RollingHorizonPlanner> rollingPlan;
+    int rollingWindowDays;
+    
+    // Plans of the last PARETO_FRONTIER run, as compact genomes
+    ParetoFrontier frontier;
+
+    // Add (sign 1) or withdraw (sign -1) a course's hours from the totals
+    void tallyCourse(size_t index, int sign) {
+        totalHoursNeeded += sign * courses[index]->getTotalHours();
+        totalHoursCompleted += sign * courses[index]->getCompletedHours();
+    }
+    
+    // Course names are unique: a course whose name is taken is refused (false)
+    bool appendCourse(shared_ptr<Course> course) {
+        courses.push_back(move(course));
+        if (!courseIndexByName.insert(courses.size() - 1, courses)) {
+            courses.pop_back();
+            return false;
+        }
+        prerequisites.addNode();
+        tallyCourse(courses.size() - 1, 1);
+        refreshCourse(courses.size() - 1);
+        return true;
+    }
+    
+    // Re-key a course after its progress changed. A course that becomes
+    // active without being tracked can't be placed incrementally, so the
+    // tracked schedule is dropped instead.
+    void refreshCourse(size_t index) {
+        const auto& course = courses[index];
+        if (course->getRemainingHours() > 0 && course->getPriority() > 0) {
+            courseQueue.update(index, course->getPriority());
+            if (liveSchedule && !liveSchedule->tracks(course.get())) liveSchedule.reset();
+        } else {
+            courseQueue.remove(index);
+        }
+    }
+
+    // Immutable inputs of one planning run. Strategies only read it, so a
+    // single snapshot can be shared by concurrent strategy runs.
+    struct PlanningSnapshot {
+        vector<shared_ptr<Course>> activeCourses;   // priority order, see rankedCount
+        vector<vector<uint32_t>> prerequisites;     // active prerequisites, by position
+        bool hasPrerequisites;
+        // Only activeCourses[0, rankedCount) are in priority order; the
+        // rest follow in the order they were added (see takeSnapshot)
+        size_t rankedCount;
+        SlotHorizon horizon;
+        CapacityCheck capacity;
+        
+        PlanningSnapshot(const vector<shared_ptr<Course>>& active, const SlotHorizon& h)
+            : activeCourses(active), hasPrerequisites(false), rankedCount(active.size()), horizon(h) {}
+    };
+    
+    // With 'rankReachable' set, only as many courses as the slots can give
+    // a minimum session are ranked - a partial O(n + k log n) selection
+    // from the queue instead of draining all of it. Strategies that need
+    // the full order must not ask for it.
+    PlanningSnapshot takeSnapshot(bool rankReachable = false) const {
+        const int minSessionMinutes = 30;
+        vector<shared_ptr<Course>> activeCourses;
+        for (size_t i = 0; i < courses.size(); i++) {
+            if (courseQueue.contains(i)) activeCourses.push_back(courses[i]);
+        }
+        // Weekly slots repeat every week until the last exam; each course
+        // only sees the occurrences before its own exam day
+        SlotHorizon horizon = buildHorizon(activeCourses);
+        // Cheap check before any allocation work
+        CapacityCheck capacity = checkCapacity(activeCourses, horizon);
+        
+        // Every course that gets any time takes at least one minimum
+        // session, so the capacity bounds how many can be reached
+        size_t ranked = courseQueue.size();
+        long long reachable = capacity.totalCapacityMinutes / minSessionMinutes;
+        if (rankReachable && !prerequisites.hasEdges() && reachable < (long long)ranked / 4) {
+            ranked = (size_t)reachable;
+        }
+        vector<size_t> ordered = courseQueue.orderedItems(ranked);
+        if (ordered.size() < courseQueue.size()) {
+            vector<bool> isRanked(courses.size(), false);
+            for (size_t index : ordered) isRanked[index] = true;
+            for (size_t i = 0; i < courses.size(); i++) {
+                if (courseQueue.contains(i) && !isRanked[i]) ordered.push_back(i);
+            }
+        }
+        
+        PlanningSnapshot snapshot(vector<shared_ptr<Course>>(), horizon);
+        snapshot.activeCourses.reserve(ordered.size());
+        for (size_t index : ordered) snapshot.activeCourses.push_back(courses[index]);
+        snapshot.capacity = capacity;
+        snapshot.rankedCount = ranked;
+        
+        // Finished courses no longer hold anything back
+        snapshot.prerequisites.resize(ordered.size());
+        if (!prerequisites.hasEdges()) return snapshot;
+        vector<int> position(courses.size(), -1);
+        for (size_t i = 0; i < ordered.size(); i++) position[ordered[i]] = (int)i;
+        for (size_t i = 0; i < ordered.size(); i++) {
+            for (uint32_t before : prerequisites.prerequisitesOf((uint32_t)ordered[i])) {
+                if (position[before] < 0) continue;
+                snapshot.prerequisites[i].push_back((uint32_t)position[before]);
+                snapshot.hasPrerequisites = true;
+            }
+        }
+        return snapshot;
+    }
+    
+    // First day that can be planned (defaults to today)
+    int planningStartDay() const {
+        return planningStart >= 0 ? planningStart : Calendar::today();
+    }
+    
+    // Recurring slots from the planning start up to the latest exam
+    SlotHorizon buildHorizon(const vector<shared_ptr<Course>>& active) const {
+        int start = planningStartDay();
+        int lastExam = start;
+        for (const auto& course : active) {
+            lastExam = max(lastExam, course->getExamDay());
+        }
+        return SlotHorizon(availableSlots.toVector(), start, lastExam);
+    }
+    
+    int findCourse(const string& name) const {
+        return courseIndexByName.find(name, courses);
+    }
+
+public:
+    // Strategy pattern for different optimization algorithms
+    enum OptimizationStrategy {
+        PRIORITY_BASED,
+        TIME_BALANCED,
+        DIFFICULTY_FIRST,
+        EARLIEST_DEADLINE_FIRST,
+        MIN_COST_FLOW,
+        SPACED_REPETITION,    // expanding gaps between sessions up to the exam
+        ROLLING_WINDOW,       // sessions for the next few days, reservations after
+        PARETO_FRONTIER,      // several plans trading coverage, balance and earliness
+        BEST_OF_ALL           // run every strategy in parallel, keep the best
+    };
+    
+    static string strategyName(OptimizationStrategy mode) {
+        switch (mode) {
+            case PRIORITY_BASED: return "Priority-based";
+            case TIME_BALANCED: return "Time-balanced";
+            case DIFFICULTY_FIRST: return "Difficulty-first";
+            case EARLIEST_DEADLINE_FIRST: return "Earliest deadline first";
+            case MIN_COST_FLOW: return "Min-cost flow";
+            case SPACED_REPETITION: return "Spaced repetition";
+            case ROLLING_WINDOW: return "Rolling window";
+            case PARETO_FRONTIER: return "Trade-offs";
+            case BEST_OF_ALL: return "Best of all";
+        }
+        return "Unknown";
+    }
+    
+    // One row of a strategy comparison
+    struct StrategyResult {
+        OptimizationStrategy strategy;
+        ScheduleObjectives objectives;
+        double milliseconds;
+        bool skipped;           // not run (e.g. solver on an over-capacity plan)
+    };
+    
+    struct StrategyComparison {
+        vector<StrategyResult> results;
+        size_t bestIndex;
+        double wallMilliseconds;
+        
+        void display() const {
+            cout << "\n" << left << setw(26) << "Strategy" << setw(10) << "Score" 
+                 << setw(10) << "Coverage" << setw(9) << "Balance" << setw(11) << "Earliness" 
+                 << "Time" << endl;
+            for (size_t i = 0; i < results.size(); i++) {
+                const auto& r = results[i];
+                cout << left << setw(26) << strategyName(r.strategy);
+                if (r.skipped) {
+                    cout << "(skipped - plan is over capacity)" << right << endl;
+                    continue;
+                }
+                cout << fixed << setprecision(3) << setw(10) << r.objectives.combined()
+                     << setw(10) << r.objectives.coverage << setw(9) << r.objectives.balance
+                     << setw(11) << r.objectives.earliness 
+                     << setprecision(2) << r.milliseconds << " ms"
+                     << (i == bestIndex ? "  <- best" : "") << right << endl;
+            }
+            cout << "Wall time: " << fixed << setprecision(2) << wallMilliseconds << " ms" << endl;
+        }
+    };
+    
+private:
+    OptimizationStrategy strategy;
+    SlotAllocator::FitPolicy fitPolicy;
+    int planningStart;        // Calendar day number, -1 = today
+    StudyLimits limits;
+    
+public:
+    ScheduleOptimizer() 
+        : totalHoursNeeded(0), totalHoursCompleted(0),
+          rollingWindowDays(7), strategy(PRIORITY_BASED), fitPolicy(SlotAllocator::BEST_FIT), 
+          planningStart(-1) {}
+    
+    // Add course to the system; throws invalid_argument if the name is taken
+    void addCourse(shared_ptr<Course> course) {
+        string name = course->getName();
+        if (!appendCourse(move(course))) throw invalid_argument("Course already exists: " + name);
+        rollingPlan.reset();
+        liveSchedule.reset();
+    }
+    
+    // Bulk-load a CSV of Course::serialize records straight into the course
+    // tables. Bad lines and names already in use are skipped and listed in
+    // 'report'. Returns false if the file can't be opened.
+    bool importCourses(const string& filename, ImportReport& report) {
+        auto started = chrono::steady_clock::now();
+        MappedFile file(filename);
+        if (!file.isOpen()) return false;
+        
+        string_view text = file.data();
+        // Rough row estimate (short records run about 32 bytes) to avoid regrowth
+        size_t expected = courses.size() + text.size() / 32;
+        courses.reserve(expected);
+        courseIndexByName.reserve(expected);
+        prerequisites.reserve(expected);
+        
+        CourseRecordScanner::scan(text,
+            [&](size_t line, const string_view (&field)[5]) {
+                shared_ptr<Course> course;
+                try {
+                    course = Course::fromFields(field);
+                } catch (const invalid_argument& e) {
+                    report.errors.push_back({line, e.what()});
+                    return;
+                }
+                if (!appendCourse(course)) {
+                    report.errors.push_back({line, "Course already exists: " + course->getName()});
+                    return;
+                }
+                report.imported++;
+            },
+            [&](size_t line, const char* message) {
+                report.errors.push_back({line, message});
+            });
+        
+        if (report.imported > 0) {
+            rollingPlan.reset();
+            liveSchedule.reset();
+        }
+        report.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+        return true;
+    }
+    
+    // Log progress on a course and reorder it in O(log n). If a schedule
+    // is being tracked, 'diff' receives the sessions that changed.
+    bool addStudyHours(const string& courseName, int hours, ScheduleDiff* diff = nullptr) {
+        int index = findCourse(courseName);
+        // Same rule as Course::addStudyHours, which ignores anything else
+        if (index < 0 || hours < 0 || 
+            courses[index]->getCompletedHours() + hours > courses[index]->getTotalHours()) {
+            return false;
+        }
+        
+        tallyCourse(index, -1);
+        courses[index]->addStudyHours(hours);
+        tallyCourse(index, 1);
+        refreshCourse(index);
+        if (liveSchedule) {
+            ScheduleDiff change = liveSchedule->courseProgressed(courses[index].get());
+            if (diff) *diff = change;
+        }
+        return true;
+    }
+    
+    bool setHoursCompleted(const string& courseName, int hours, ScheduleDiff* diff = nullptr) {
+        int index = findCourse(courseName);
+        if (index < 0) return false;
+        
+        tallyCourse(index, -1);
+        courses[index]->setHoursCompleted(hours);
+        tallyCourse(index, 1);
+        refreshCourse(index);
+        if (liveSchedule) {
+            ScheduleDiff change = liveSchedule->courseProgressed(courses[index].get());
+            if (diff) *diff = change;
+        }
+        return courses[index]->getCompletedHours() == hours;
+    }
+    
+    // Move a course's exam; throws invalid_argument for a malformed date
+    bool moveExam(const string& courseName, const string& examDate, ScheduleDiff* diff = nullptr) {
+        int index = findCourse(courseName);
+        if (index < 0) return false;
+        
+        courses[index]->setExamDate(examDate);
+        refreshCourse(index);
+        rollingPlan.reset();
+        if (liveSchedule) {
+            ScheduleDiff change = liveSchedule->examMoved(courses[index].get());
+            if (diff) *diff = change;
+        }
+        return true;
+    }
+    
+    bool removeTimeSlot(size_t index, ScheduleDiff* diff = nullptr) {
+        TimeSlot removed(0, 0);
+        if (!availableSlots.eraseAt(index, removed)) return false;
+        weeklyAvailability.removeSlot(removed);
+        rollingPlan.reset();
+        if (liveSchedule) {
+            ScheduleDiff change = liveSchedule->slotRemoved(removed);
+            if (diff) *diff = change;
+        }
+        return true;
+    }
+    
+    // 'before' must be studied before 'after'. Returns false for an unknown
+    // course; throws invalid_argument if the edge would close a cycle.
+    bool addPrerequisite(const string& before, const string& after) {
+        int first = findCourse(before), second = findCourse(after);
+        if (first < 0 || second < 0) return false;
+        if (first == second) throw invalid_argument("a course can't be its own prerequisite");
+        if (!prerequisites.addEdge((uint32_t)first, (uint32_t)second)) {
+            throw invalid_argument(after + " is already required before " + before);
+        }
+        rollingPlan.reset();
+        liveSchedule.reset();
+        return true;
+    }
+    
+    // Keep 'schedule' live: later progress, exam and slot changes re-place
+    // only the sessions they affect. Rolling-window plans are not tracked:
+    // top-ups would book days beyond the window, and the rolling planner
+    // already follows progress on its next run.
+    void trackSchedule(const Schedule& schedule) {
+        if (strategy == ROLLING_WINDOW) {
+            liveSchedule.reset();
+            return;
+        }
+        PlanningSnapshot snapshot = takeSnapshot();
+        liveSchedule.reset(new IncrementalScheduler(snapshot.activeCourses, availableSlots.toVector(),
+                                                    snapshot.horizon.getStartDay(),
+                                                    snapshot.horizon.getEndDay(), schedule, limits));
+    }
+    
+    bool isTrackingSchedule() const { return liveSchedule != nullptr; }
+    
+    Schedule getTrackedSchedule() const {
+        if (!liveSchedule) return Schedule("Optimized Study Schedule");
+        Schedule schedule = liveSchedule->currentSchedule();
+        attachFeasibilityReport(takeSnapshot().activeCourses, schedule);
+        return schedule;
+    }
+    
+    // O(1) - the course that should be studied next (nullptr if none)
+    shared_ptr<Course> getNextCourse() const {
+        if (courseQueue.empty()) return nullptr;
+        return courses[courseQueue.top()];
+    }
+    
+    // Add available time slot. Overlapping or touching slots on the same
+    // day are merged, so no wall-clock time is offered twice; returns how
+    // many existing slots it absorbed.
+    int addTimeSlot(const TimeSlot& slot) {
+        int merged = availableSlots.insert(slot);
+        weeklyAvailability.addSlot(slot);
+        rollingPlan.reset();
+        liveSchedule.reset();
+        return merged;
+    }
+    
+    // O(log n) lookups on the merged slots (minutes since Monday 00:00)
+    bool isFreeAt(int minuteOfWeek) const { return availableSlots.isFreeAt(minuteOfWeek); }
+    
+    vector<TimeSlot> getSlotsInRange(int fromMinute, int toMinute) const {
+        return availableSlots.slotsInRange(fromMinute, toMinute);
+    }
+    
+    // Merged view of all slots at 15-minute resolution
+    const AvailabilityBitmap& getAvailability() const {
+        return weeklyAvailability;
+    }
+    
+    // Windows of at least 'minMinutes' when this student and every other
+    // group member are free
+    vector<TimeSlot> findGroupStudyTimes(const vector<vector<TimeSlot>>& others, int minMinutes) const {
+        vector<AvailabilityBitmap> group(1, weeklyAvailability);
+        for (const auto& slots : others) group.push_back(GroupStudyFinder::toBitmap(slots));
+        return GroupStudyFinder::commonWindows(group, minMinutes);
+    }
+    
+    double getFreeHoursBefore(int dayIndex) const {
+        return weeklyAvailability.freeMinutesBeforeDay(dayIndex) / 60.0;
+    }
+    
+    // Set optimization strategy
+    void setStrategy(OptimizationStrategy strat) {
+        strategy = strat;
+    }
+    
+    OptimizationStrategy getStrategy() const { return strategy; }
+    
+    // How sessions are packed into partially used slots
+    void setFitPolicy(SlotAllocator::FitPolicy policy) {
+        fitPolicy = policy;
+    }
+    
+    // Plan from a fixed date instead of today (YYYY-MM-DD)
+    void setPlanningStart(const string& isoDate) {
+        planningStart = Calendar::parseIsoDate(isoDate);
+        rollingPlan.reset();
+        liveSchedule.reset();
+    }
+    
+    // Daily caps and breaks honoured by every strategy
+    void setStudyLimits(const StudyLimits& studyLimits) {
+        limits = studyLimits;
+        rollingPlan.reset();
+        liveSchedule.reset();
+    }
+    
+    const StudyLimits& getStudyLimits() const { return limits; }
+    
+    // Number of days ROLLING_WINDOW mode books real sessions for
+    void setRollingWindow(int days) {
+        rollingWindowDays = max(1, days);
+        rollingPlan.reset();
+    }
+    
+    // IMPROVED: Generate optimized schedule with better logic
+    Schedule generateSchedule() {
+        // The queue only holds active courses (completed courses and past
+        // exams are dropped as their progress is logged), already in
+        // priority order - no copy-and-sort needed here
+        if (courseQueue.empty()) {
+            cout << "No active courses to schedule!" << endl;
+            return Schedule("Optimized Study Schedule");
+        }
+        
+        // The greedy priority pass only needs the courses it can reach ranked
+        PlanningSnapshot snapshot = takeSnapshot(strategy == PRIORITY_BASED);
+        if (!limits.isUnlimited()) limits.display();
+        snapshot.capacity.display();
+        if (snapshot.capacity.isHopeless()) {
+            cout << "No study time is available before any exam - add time slots first." << endl;
+            return Schedule("Optimized Study Schedule");
+        }
+        
+        if (strategy == BEST_OF_ALL) {
+            Schedule best("Optimized Study Schedule");
+            StrategyComparison comparison = compareStrategies(snapshot, best);
+            comparison.display();
+            return best;
+        }
+        
+        if (strategy == ROLLING_WINDOW) {
+            return planRollingWindow(snapshot);
+        }
+        
+        if (strategy == PARETO_FRONTIER) {
+            frontier = computeParetoFrontier(snapshot);
+            frontier.display();
+            if (frontier.empty()) return Schedule("Optimized Study Schedule");
+            cout << "Plan " << frontier.bestCombined() + 1 << " has the best combined score." << endl;
+            return paretoSchedule(frontier.bestCombined());
+        }
+        
+        OptimizationStrategy mode = strategy;
+        if (!snapshot.capacity.isFeasible() && mode == MIN_COST_FLOW) {
+            // The heavy solver only runs on instances that fit; an
+            // over-capacity plan gets a fast best-effort EDF schedule
+            cout << "Plan is over capacity - using earliest deadline first instead of the solver." << endl;
+            mode = EARLIEST_DEADLINE_FIRST;
+        }
+        return runStrategy(mode, snapshot);
     }
     
-    void displayInfo() const {
-        cout << day << " " << startTime << "-" << endTime 
-             << " (" << getDurationHours() << "h) " 
-             << (available ? "Available" : "Booked") << endl;
+    // Book the next few days and reserve time for the rest. A plan made on
+    // an earlier day is slid forward instead of rebuilt, so only days that
+    // entered the window since then are planned.
+    Schedule planRollingWindow(const PlanningSnapshot& snapshot) {
+        int start = snapshot.horizon.getStartDay();
+        if (rollingPlan && start >= rollingPlan->getWindowStart()) {
+            rollingPlan->advanceTo(start);
+        } else {
+            rollingPlan.reset(new RollingHorizonPlanner(snapshot.activeCourses, availableSlots.toVector(),
+                                                        rollingWindowDays, start, limits));
+        }
+        rollingPlan->displayReservations();
+        return rollingPlan->getWindowSchedule();
     }
-};
-
-// ==================== STUDY SESSION CLASS ====================
-class StudySession {
-private:
-    shared_ptr<Course> course;
-    TimeSlot timeSlot;
-    int duration;
-    
-public:
-    StudySession(shared_ptr<Course> c, const TimeSlot& slot, int dur)
-        : course(c), timeSlot(slot), duration(dur) {}
     
-    shared_ptr<Course> getCourse() const { return course; }
-    TimeSlot getTimeSlot() const { return timeSlot; }
-    int getDuration() const { return duration; }
+    // Evolve schedules that trade coverage, balance and earliness against
+    // each other, seeded with the priority, deadline and difficulty orders
+    ParetoFrontier computeParetoFrontier(const PlanningSnapshot& snapshot,
+                                         const ParetoOptions& options = ParetoOptions()) const {
+        const auto& activeCourses = snapshot.activeCourses;
+        vector<uint32_t> byPriority(activeCourses.size());
+        for (uint32_t i = 0; i < byPriority.size(); i++) byPriority[i] = i;
+        vector<uint32_t> byExam = byPriority, byDifficulty = byPriority;
+        stable_sort(byExam.begin(), byExam.end(), [&](uint32_t a, uint32_t b) {
+            return activeCourses[a]->getExamDay() < activeCourses[b]->getExamDay();
+        });
+        stable_sort(byDifficulty.begin(), byDifficulty.end(), [&](uint32_t a, uint32_t b) {
+            return activeCourses[a]->getDifficulty() > activeCourses[b]->getDifficulty();
+        });
+        
+        auto decoder = make_shared<ScheduleDecoder>(activeCourses, snapshot.horizon, limits);
+        return ParetoSearch(decoder).run(options, {byPriority, byExam, byDifficulty});
+    }
     
-    void displayInfo() const {
-        cout << "Study Session: " << course->getName() << endl;
-        cout << "Time: " << timeSlot.getDay() << " " 
-             << timeSlot.getStartTime() << "-" << timeSlot.getEndTime() << endl;
-        cout << "Duration: " << duration << " hours" << endl;
+    ParetoFrontier computeParetoFrontier(const ParetoOptions& options) const {
+        return computeParetoFrontier(takeSnapshot(), options);
     }
-};
-
-// ==================== SCHEDULE CLASS ====================
-class Schedule : public Persistable {
-private:
-    vector<StudySession> sessions;
-    string scheduleName;
     
-public:
-    Schedule(const string& name) : scheduleName(name) {}
+    // Frontier of the last PARETO_FRONTIER run
+    const ParetoFrontier& getParetoFrontier() const { return frontier; }
     
-    void addSession(const StudySession& session) {
-        sessions.push_back(session);
+    // Decode one plan of that frontier, with its feasibility report
+    Schedule paretoSchedule(size_t plan) const {
+        Schedule schedule = frontier.schedule(plan);
+        attachFeasibilityReport(frontier.getCourses(), schedule);
+        return schedule;
     }
     
-    void displaySchedule() const {
-        cout << "\n=== " << scheduleName << " ===" << endl;
-        cout << "Total Sessions: " << sessions.size() << endl;
+    // Run every strategy concurrently on the shared pool and keep the one
+    // with the best combined objective
+    StrategyComparison compareStrategies(const PlanningSnapshot& snapshot, Schedule& best) const {
+        static const OptimizationStrategy modes[] = {
+            PRIORITY_BASED, TIME_BALANCED, DIFFICULTY_FIRST, 
+            EARLIEST_DEADLINE_FIRST, MIN_COST_FLOW, SPACED_REPETITION
+        };
         
-        if (sessions.empty()) {
-            cout << "No study sessions scheduled." << endl;
-            cout << "This could mean:" << endl;
-            cout << "- All courses are complete" << endl;
-            cout << "- No available time slots" << endl;
-            cout << "- All exam dates have passed" << endl;
-            return;
+        auto wallStart = chrono::steady_clock::now();
+        vector<future<pair<Schedule, double>>> pending;
+        StrategyComparison comparison;
+        for (OptimizationStrategy mode : modes) {
+            StrategyResult row;
+            row.strategy = mode;
+            row.milliseconds = 0;
+            row.skipped = mode == MIN_COST_FLOW && !snapshot.capacity.isFeasible();
+            comparison.results.push_back(row);
+            if (row.skipped) continue;
+            
+            // The snapshot is only read, so all tasks can share it
+            pending.push_back(ThreadPool::shared().submit([this, mode, &snapshot] {
+                auto start = chrono::steady_clock::now();
+                Schedule result = runStrategy(mode, snapshot);
+                chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+                return make_pair(move(result), elapsed.count());
+            }));
         }
         
-        cout << "\nDetailed Schedule:" << endl;
-        cout << string(50, '-') << endl;
-        
-        for (const auto& session : sessions) {
-            session.displayInfo();
-            cout << string(30, '-') << endl;
+        comparison.bestIndex = 0;
+        double bestScore = -1;
+        size_t next = 0;
+        for (size_t i = 0; i < comparison.results.size(); i++) {
+            StrategyResult& row = comparison.results[i];
+            if (row.skipped) continue;
+            pair<Schedule, double> outcome = ThreadPool::shared().wait(pending[next++]);
+            row.milliseconds = outcome.second;
+            row.objectives = ScheduleObjectives::evaluate(outcome.first, snapshot.activeCourses, 
+                                                          snapshot.horizon);
+            if (row.objectives.combined() > bestScore) {
+                bestScore = row.objectives.combined();
+                comparison.bestIndex = i;
+                best = move(outcome.first);
+            }
         }
+        
+        chrono::duration<double, milli> wall = chrono::steady_clock::now() - wallStart;
+        comparison.wallMilliseconds = wall.count();
+        return comparison;
     }
     
-    int getTotalStudyHours() const {
-        int total = 0;
-        for (const auto& session : sessions) {
-            total += session.getDuration();
-        }
-        return total;
+    StrategyComparison compareStrategies() const {
+        Schedule best("Optimized Study Schedule");
+        return compareStrategies(takeSnapshot(), best);
     }
     
-    // Serialization
-    string serialize() const override {
-        stringstream ss;
-        ss << scheduleName << "\n";
-        ss << sessions.size() << "\n";
-        for (const auto& session : sessions) {
-            ss << session.getCourse()->getName() << ","
-               << session.getTimeSlot().getDay() << ","
-               << session.getTimeSlot().getStartTime() << ","
-               << session.getTimeSlot().getEndTime() << ","
-               << session.getDuration() << "\n";
-        }
-        return ss.str();
+    // Monte Carlo estimate of each active course's chance to finish before
+    // its exam when sessions are missed or overrun (see CompletionRiskSimulator)
+    RiskReport simulateCompletionRisk(const Schedule& schedule, 
+                                      const RiskOptions& options = RiskOptions()) const {
+        return CompletionRiskSimulator::simulate(takeSnapshot().activeCourses, schedule, options);
     }
     
-    void deserialize(const string& data) override {
-        // Implementation for loading saved schedules
-        // This would parse the serialized data and reconstruct the schedule
+    // Local-search pass over any schedule built from the current courses
+    // and slots (see ScheduleAnnealer)
+    Schedule improveSchedule(const Schedule& start, 
+                             const AnnealingOptions& options = AnnealingOptions()) const {
+        PlanningSnapshot snapshot = takeSnapshot();
+        ScheduleAnnealer annealer(snapshot.activeCourses, snapshot.horizon, limits);
+        Schedule improved = annealer.improve(start, options);
+        attachFeasibilityReport(snapshot.activeCourses, improved);
+        return improved;
     }
-};
-
-// ==================== SCHEDULE OPTIMIZER CLASS (MAIN LOGIC) ====================
-class ScheduleOptimizer {
-private:
-    vector<shared_ptr<Course>> courses;
-    vector<TimeSlot> availableSlots;
-    
-    // Strategy pattern for different optimization algorithms
-    enum OptimizationStrategy {
-        PRIORITY_BASED,
-        TIME_BALANCED,
-        DIFFICULTY_FIRST
-    };
     
-    OptimizationStrategy strategy;
+    // Only reads the snapshot, so it is safe to call from several threads
+    Schedule runStrategy(OptimizationStrategy mode, const PlanningSnapshot& snapshot) const {
+        Schedule schedule("Optimized Study Schedule");
+        const auto& activeCourses = snapshot.activeCourses;
+        const auto& horizon = snapshot.horizon;
+        
+        switch (mode) {
+            case TIME_BALANCED:
+                allocateRoundRobin(activeCourses, horizon, schedule);
+                break;
+            case DIFFICULTY_FIRST: {
+                vector<uint32_t> hardestFirst(activeCourses.size());
+                for (uint32_t i = 0; i < hardestFirst.size(); i++) hardestFirst[i] = i;
+                stable_sort(hardestFirst.begin(), hardestFirst.end(), [&](uint32_t a, uint32_t b) {
+                    return activeCourses[a]->getDifficulty() > activeCourses[b]->getDifficulty();
+                });
+                allocateByPriority(snapshot, hardestFirst, schedule);
+                break;
+            }
+            case EARLIEST_DEADLINE_FIRST:
+                allocateEarliestDeadlineFirst(activeCourses, horizon, schedule);
+                break;
+            case MIN_COST_FLOW:
+                allocateMinCostFlow(activeCourses, horizon, schedule);
+                break;
+            case SPACED_REPETITION:
+                allocateSpacedRepetition(activeCourses, horizon, schedule);
+                break;
+            default: {
+                vector<uint32_t> priorityOrder(activeCourses.size());
+                for (uint32_t i = 0; i < priorityOrder.size(); i++) priorityOrder[i] = i;
+                allocateByPriority(snapshot, priorityOrder, schedule);
+                break;
+            }
+        }
+        
+        attachFeasibilityReport(activeCourses, schedule);
+        return schedule;
+    }
     
-public:
-    ScheduleOptimizer() : strategy(PRIORITY_BASED) {}
+    // Total the demand per exam day and compare the running demand with the
+    // slot capacity before each exam (an O(1) prefix-sum lookup on the
+    // horizon). Only the distinct exam days are sorted, not the courses.
+    // With one shared calendar this is exactly the condition for every
+    // course to fit, so a failure here means no allocator can succeed. With
+    // study limits the daily cap tightens each capacity, but the check is
+    // then only a necessary condition.
+    CapacityCheck checkCapacity(const vector<shared_ptr<Course>>& activeCourses,
+                                const SlotHorizon& horizon) const {
+        unordered_map<int, long long> demandByDay;
+        for (const auto& course : activeCourses) {
+            demandByDay[course->getExamDay()] += (long long)course->getRemainingHours() * 60;
+        }
+        // (exam day, minutes)
+        vector<pair<int, long long>> demands(demandByDay.begin(), demandByDay.end());
+        sort(demands.begin(), demands.end());
+        
+        CapacityCheck check;
+        for (size_t i = 0; i < demands.size(); i++) {
+            check.totalDemandMinutes += demands[i].second;
+            long long capacity = limits.capCapacity(horizon.capacityBefore(demands[i].first),
+                                                    demands[i].first - horizon.getStartDay());
+            if (check.totalDemandMinutes > capacity) {
+                CapacityCheck::ExamShortfall entry;
+                entry.examDay = demands[i].first;
+                entry.demandMinutes = check.totalDemandMinutes;
+                entry.capacityMinutes = capacity;
+                check.shortfalls.push_back(entry);
+            }
+        }
+        if (!demands.empty()) {
+            check.totalCapacityMinutes = limits.capCapacity(horizon.capacityBefore(demands.back().first),
+                                                            demands.back().first - horizon.getStartDay());
+        }
+        return check;
+    }
     
-    // Add course to the system
-    void addCourse(shared_ptr<Course> course) {
-        courses.push_back(course);
+    // Round robin: courses take turns booking one session of up to two
+    // hours, so every course makes progress every week
+    void allocateRoundRobin(const vector<shared_ptr<Course>>& activeCourses,
+                            const SlotHorizon& horizon, Schedule& schedule) const {
+        const int turnMinutes = 120;
+        SlotAllocator allocator(horizon, SlotAllocator::FIRST_FIT, limits);
+        SlotAllocator::Booking booking;
+        
+        vector<int> remaining(activeCourses.size());
+        for (size_t i = 0; i < activeCourses.size(); i++) {
+            remaining[i] = activeCourses[i]->getRemainingHours() * 60;
+        }
+        
+        bool progress = true;
+        while (progress) {
+            progress = false;
+            for (size_t i = 0; i < activeCourses.size(); i++) {
+                if (remaining[i] <= 0) continue;
+                uint32_t beforeExam = horizon.firstOnOrAfter(activeCourses[i]->getExamDay());
+                if (!allocator.allocate(min(remaining[i], turnMinutes), beforeExam, booking, (uint32_t)i)) {
+                    remaining[i] = 0;   // nothing left before this exam
+                    continue;
+                }
+                schedule.addSession(activeCourses[i], booking.occurrence.day, booking.startMinute, booking.minutes);
+                remaining[i] -= booking.minutes;
+                progress = true;
+            }
+        }
+        
+        schedule.setUtilization(allocator.getBookedMinutes(), allocator.getTotalMinutes());
     }
     
-    // Add available time slot
-    void addTimeSlot(const TimeSlot& slot) {
-        availableSlots.push_back(slot);
+    // Greedy: each course in 'preferred' order (positions in the snapshot)
+    // takes what is left before its exam. Prerequisites are moved ahead of
+    // the courses that need them, and a course only uses occurrences after
+    // the last one given to any of its prerequisites.
+    void allocateByPriority(const PlanningSnapshot& snapshot, const vector<uint32_t>& preferred,
+                            Schedule& schedule) const {
+        const auto& activeCourses = snapshot.activeCourses;
+        const auto& horizon = snapshot.horizon;
+        // Slots keep their unbooked remainder, so one slot can take
+        // several sessions
+        SlotAllocator allocator(horizon, fitPolicy, limits);
+        SlotAllocator::Booking booking;
+        vector<long long> lastOccurrence(activeCourses.size(), -1);
+        
+        vector<uint32_t> order = snapshot.hasPrerequisites
+            ? PrerequisiteGraph::schedulingOrder(snapshot.prerequisites, preferred) : preferred;
+        // Past the ranked courses (priority order only) the rest are ranked
+        // on demand: those whose exam comes before any time that is still
+        // free are dropped, then as many as the free time can reach are
+        // selected. Ties go to the earlier course, as in the queue.
+        size_t ranked = snapshot.rankedCount;
+        vector<double> key;
+        vector<uint32_t> examId;
+        auto higher = [&](uint32_t a, uint32_t b) {
+            return key[a] != key[b] ? key[a] > key[b] : a < b;
+        };
+        for (size_t k = 0; k < order.size(); k++) {
+            if (k == ranked) {
+                if (key.empty()) {
+                    key.resize(activeCourses.size());
+                    examId.resize(activeCourses.size());
+                    for (size_t c = k; c < order.size(); c++) {
+                        key[order[c]] = activeCourses[order[c]]->getPriority();
+                        examId[order[c]] = horizon.firstOnOrAfter(activeCourses[order[c]]->getExamDay());
+                    }
+                }
+                uint32_t room = allocator.firstRoom();
+                order.erase(partition(order.begin() + k, order.end(), 
+                                      [&](uint32_t c) { return examId[c] > room; }), order.end());
+                if (k == order.size()) break;
+                long long reach = (allocator.getTotalMinutes() - allocator.getBookedMinutes()) / 30;
+                ranked = (size_t)min<long long>((long long)order.size(), (long long)k + max(reach, 64LL));
+                partial_sort(order.begin() + k, order.begin() + ranked, order.end(), higher);
+            }
+            uint32_t i = order[k];
+            const auto& course = activeCourses[i];
+            int remainingMinutes = course->getRemainingHours() * 60;
+            uint32_t beforeExam = horizon.firstOnOrAfter(course->getExamDay());
+            uint32_t afterPrerequisites = 0;
+            for (uint32_t before : snapshot.prerequisites[i]) {
+                afterPrerequisites = max(afterPrerequisites, (uint32_t)(lastOccurrence[before] + 1));
+            }
+            
+            while (remainingMinutes > 0 && 
+                   allocator.allocate(remainingMinutes, beforeExam, booking, i, afterPrerequisites)) {
+                schedule.addSession(course, booking.occurrence.day, booking.startMinute, booking.minutes);
+                remainingMinutes -= booking.minutes;
+                lastOccurrence[i] = max(lastOccurrence[i], (long long)booking.occurrence.id);
+            }
+        }
+        
+        schedule.setUtilization(allocator.getBookedMinutes(), allocator.getTotalMinutes());
     }
     
-    // Set optimization strategy
-    void setStrategy(OptimizationStrategy strat) {
-        strategy = strat;
+    // Earliest deadline first over the whole horizon (see DeadlineAllocator)
+    void allocateEarliestDeadlineFirst(const vector<shared_ptr<Course>>& activeCourses,
+                                       const SlotHorizon& horizon, Schedule& schedule) const {
+        vector<int> demand(activeCourses.size());
+        for (size_t i = 0; i < activeCourses.size(); i++) {
+            demand[i] = activeCourses[i]->getRemainingHours() * 60;
+        }
+        long long bookedMinutes = DeadlineAllocator::allocate(activeCourses, demand, horizon, schedule, limits);
+        schedule.setUtilization(bookedMinutes, horizon.capacityBefore(horizon.getEndDay()));
     }
     
-    // IMPROVED: Generate optimized schedule with better logic
-    Schedule generateSchedule() {
-        Schedule schedule("Optimized Study Schedule");
+    // Spaced repetition: a course's remaining time is cut into sessions of
+    // about an hour and a half whose target days lie on an expanding
+    // curve - each gap is 'growth' times the previous one - from the
+    // planning start to the day before the exam. Each session goes to the
+    // first occurrence on or after its target with room for it, else the
+    // closest one before it; the free capacity tree answers both in
+    // O(log S), plus O(log S) per day skipped for being at its cap.
+    // Courses with the nearest exams claim their days first.
+    void allocateSpacedRepetition(const vector<shared_ptr<Course>>& activeCourses,
+                                  const SlotHorizon& horizon, Schedule& schedule) const {
+        const int sessionMinutes = 90;
+        const int minSessionMinutes = 30;
+        const double growth = 1.5;
         
-        // Filter out completed courses and past exams
-        vector<shared_ptr<Course>> activeCourses;
-        for (auto& course : courses) {
-            if (course->getRemainingHours() > 0 && course->getPriority() > 0) {
-                activeCourses.push_back(course);
+        FreeCapacityTree capacity(horizon, limits.minBreakMinutes);
+        DailyLoad load(limits, horizon.getStartDay());
+        vector<size_t> byExam(activeCourses.size());
+        for (size_t i = 0; i < byExam.size(); i++) byExam[i] = i;
+        stable_sort(byExam.begin(), byExam.end(), [&](size_t a, size_t b) {
+            return activeCourses[a]->getExamDay() < activeCourses[b]->getExamDay();
+        });
+        
+        long long bookedMinutes = 0;
+        for (size_t index : byExam) {
+            const auto& course = activeCourses[index];
+            int remaining = course->getRemainingHours() * 60;
+            int firstDay = horizon.getStartDay();
+            int lastDay = course->getExamDay() - 1;
+            uint32_t examId = horizon.firstOnOrAfter(course->getExamDay());
+            if (remaining <= 0 || lastDay < firstDay) continue;
+            
+            int sessions = (remaining + sessionMinutes - 1) / sessionMinutes;
+            // Round each session to 15 minutes so slots stay easy to share
+            int chunk = ((remaining + sessions - 1) / sessions + 14) / 15 * 15;
+            // Gap k is unit * growth^k; the gaps add up to the whole span
+            double unit = sessions > 1 
+                ? (lastDay - firstDay) * (growth - 1) / (pow(growth, sessions - 1) - 1) : 0;
+            
+            // Time a shortened session left over is placed close before the exam
+            for (int k = 0; remaining > 0; k++) {
+                int target = sessions > 1 && k < sessions
+                    ? firstDay + (int)llround(unit * (pow(growth, k) - 1) / (growth - 1)) : lastDay;
+                uint32_t targetId = horizon.firstOnOrAfter(target);
+                int wanted = min(chunk, remaining);
+                
+                // Shrink the session if nothing before the exam holds all of it
+                int largest = capacity.maxFree(0, examId);
+                if (largest < wanted) {
+                    if (largest < minSessionMinutes) break;
+                    wanted = largest;
+                }
+                // Days already at their cap are stepped over a day at a time
+                auto allowed = [&](int id) {
+                    return load.allowance((uint32_t)index, horizon.at(id).day) >= min(wanted, minSessionMinutes);
+                };
+                int id = capacity.firstFit(targetId, examId, wanted);
+                while (id >= 0 && !allowed(id)) {
+                    id = capacity.firstFit(horizon.firstOnOrAfter(horizon.at(id).day + 1), examId, wanted);
+                }
+                if (id < 0) {
+                    id = capacity.lastFit(0, targetId, wanted);
+                    while (id >= 0 && !allowed(id)) {
+                        id = capacity.lastFit(0, horizon.firstOnOrAfter(horizon.at(id).day), wanted);
+                    }
+                }
+                if (id < 0) break;
+                
+                SlotOccurrence occ = horizon.at(id);
+                wanted = min(wanted, load.allowance((uint32_t)index, occ.day));
+                load.add((uint32_t)index, occ.day, wanted);
+                int start = capacity.take(id, wanted);
+                schedule.addSession(course, occ.day, start, wanted);
+                remaining -= wanted;
+                bookedMinutes += wanted;
             }
         }
         
-        if (activeCourses.empty()) {
-            cout << "No active courses to schedule!" << endl;
-            return schedule;
+        schedule.setUtilization(bookedMinutes, horizon.capacityBefore(horizon.getEndDay()));
+    }
+    
+    // Exact mode: source -> course -> study day -> sink, in 15-minute units.
+    // All occurrences on one day cost the same for a given course, so they
+    // are pooled into one day node; that keeps the network at C x D edges
+    // instead of C x S. Course edges carry the remaining study time, day
+    // edges the slot capacity, and a course only links to days before its
+    // exam. The maximum flow covers as many hours as the calendar allows
+    // (so a hard course with a late exam can't be starved by greedy
+    // choices); among those, the cost prefers early study, weighted by
+    // course priority. Daily caps simply bound the day and course-day
+    // edges; breaks are inserted when the flow is laid out, and on a full
+    // day whatever no longer fits after them is left out.
+    void allocateMinCostFlow(const vector<shared_ptr<Course>>& activeCourses,
+                             const SlotHorizon& horizon, Schedule& schedule) const {
+        const int unit = 15;
+        const int noCap = numeric_limits<int>::max();
+        int dayCapUnits = limits.maxMinutesPerDay > 0 ? limits.maxMinutesPerDay / unit : noCap;
+        int courseCapUnits = limits.maxCourseMinutesPerDay > 0 ? limits.maxCourseMinutesPerDay / unit : noCap;
+        
+        // Study days in the horizon with their occurrence range and capacity
+        struct StudyDay { int day; uint32_t firstId, endId; int units; };
+        vector<StudyDay> days;
+        for (SlotOccurrence occ : horizon) {
+            int units = occ.getDurationMinutes() / unit;
+            if (days.empty() || days.back().day != occ.day) {
+                days.push_back({occ.day, occ.id, occ.id, 0});
+            }
+            days.back().endId = occ.id + 1;
+            days.back().units += units;
         }
         
-        // Sort courses by priority (polymorphism in action)
-        sort(activeCourses.begin(), activeCourses.end(), 
-             [](const shared_ptr<Course>& a, const shared_ptr<Course>& b) {
-                 return a->getPriority() > b->getPriority();
-             });
+        const int courseCount = (int)activeCourses.size();
+        const int dayCount = (int)days.size();
+        const int source = 0;
+        const int firstCourse = 1;
+        const int firstDay = firstCourse + courseCount;
+        const int sink = firstDay + dayCount;
         
-        // Create a copy of available slots to modify
-        vector<TimeSlot> workingSlots = availableSlots;
+        MinCostFlowSolver solver(sink + 1);
+        vector<vector<pair<int, int>>> courseEdges(courseCount);   // (edge id, day index)
         
-        // Allocate study sessions
-        for (auto& course : activeCourses) {
-            int remainingHours = course->getRemainingHours();
+        for (int c = 0; c < courseCount; c++) {
+            const auto& course = activeCourses[c];
+            solver.addEdge(source, firstCourse + c, course->getRemainingHours() * 60 / unit, 0);
             
-            for (auto& slot : workingSlots) {
-                if (remainingHours <= 0) break;
-                if (!slot.isAvailable()) continue;
-                
-                int sessionHours = min(remainingHours, slot.getDurationHours());
+            long long weight = 1 + (long long)llround(course->getPriority());
+            for (int d = 0; d < dayCount && days[d].day < course->getExamDay(); d++) {
+                if (days[d].units == 0) continue;
+                long long lateness = days[d].day - horizon.getStartDay() + 1;
+                int edge = solver.addEdge(firstCourse + c, firstDay + d, 
+                                          min(days[d].units, courseCapUnits), lateness * weight);
+                courseEdges[c].push_back(make_pair(edge, d));
+            }
+        }
+        for (int d = 0; d < dayCount; d++) {
+            if (days[d].units > 0) solver.addEdge(firstDay + d, sink, min(days[d].units, dayCapUnits), 0);
+        }
+        
+        solver.solve(source, sink);
+        
+        // Lay each day's flow out back-to-back through that day's occurrences
+        struct DayCursor { uint32_t id; int minute; };
+        vector<DayCursor> cursor(dayCount);
+        for (int d = 0; d < dayCount; d++) {
+            cursor[d].id = days[d].firstId;
+            cursor[d].minute = horizon.at(days[d].firstId).startMinute;
+        }
+        
+        long long bookedMinutes = 0;
+        for (int c = 0; c < courseCount; c++) {
+            for (const auto& edge : courseEdges[c]) {
+                int minutes = solver.flowOn(edge.first) * unit;
+                DayCursor& at = cursor[edge.second];
                 
-                if (sessionHours > 0) {
-                    StudySession session(course, slot, sessionHours);
-                    schedule.addSession(session);
+                while (minutes > 0) {
+                    SlotOccurrence occ = horizon.at(at.id);
+                    int usableEnd = occ.startMinute + occ.getDurationMinutes() / unit * unit;
+                    int start = at.minute > occ.startMinute ? at.minute + limits.minBreakMinutes : at.minute;
+                    int length = min(minutes, usableEnd - start);
+                    if (length <= 0) {
+                        if (at.id + 1 >= days[edge.second].endId) break;   // day is full
+                        at.id++;
+                        at.minute = horizon.at(at.id).startMinute;
+                        continue;
+                    }
                     
-                    slot.setAvailable(false);
-                    remainingHours -= sessionHours;
+                    schedule.addSession(activeCourses[c], occ.day, start, length);
+                    at.minute = start + length;
+                    minutes -= length;
+                    bookedMinutes += length;
                 }
             }
         }
         
-        return schedule;
+        schedule.setUtilization(bookedMinutes, horizon.capacityBefore(horizon.getEndDay()));
+    }
+    
+    // Required vs. scheduled minutes for every course that was planned
+    void attachFeasibilityReport(const vector<shared_ptr<Course>>& activeCourses,
+                                 Schedule& schedule) const {
+        vector<CourseFeasibility> report;
+        report.reserve(activeCourses.size());
+        for (const auto& course : activeCourses) {
+            CourseFeasibility entry;
+            entry.courseName = course->getName();
+            entry.examDay = course->getExamDay();
+            entry.requiredMinutes = course->getRemainingHours() * 60;
+            entry.scheduledMinutes = (int)schedule.getCourseMinutes(course.get());
+            report.push_back(entry);
+        }
+        schedule.setFeasibilityReport(report);
     }
     
     // Display all courses
@@ -418,8 +5146,16 @@ public:
             return;
         }
         
-        for (const auto& course : courses) {
-            course->displayInfo();
+        for (size_t i = 0; i < courses.size(); i++) {
+            courses[i]->displayInfo();
+            const auto& before = prerequisites.prerequisitesOf((uint32_t)i);
+            if (!before.empty()) {
+                cout << "Study after:";
+                for (size_t k = 0; k < before.size(); k++) {
+                    cout << (k ? ", " : " ") << courses[before[k]]->getName();
+                }
+                cout << endl;
+            }
             cout << string(40, '-') << endl;
         }
     }
@@ -432,7 +5168,7 @@ public:
             return;
         }
         
-        for (const auto& slot : availableSlots) {
+        for (const auto& slot : availableSlots.toVector()) {
             slot.displayInfo();
         }
     }
@@ -449,31 +5185,42 @@ public:
         }
     }
     
+    // Load a schedule written by saveSchedule, matching sessions to the
+    // current courses by name. Throws invalid_argument for a bad file.
+    bool loadSchedule(const string& filename, Schedule& schedule) const {
+        ifstream file(filename, ios::binary);
+        if (!file.is_open()) return false;
+        schedule.load(file, CourseNameIndex(courses));
+        return true;
+    }
+    
     // Get statistics
     void displayStatistics() const {
         cout << "\n=== STUDY STATISTICS ===" << endl;
         cout << "Total Courses: " << courses.size() << endl;
         cout << "Available Time Slots: " << availableSlots.size() << endl;
+        if (!availableSlots.empty()) {
+            cout << "Weekly Free Hours: " 
+                 << TimeSlot::formatHours(weeklyAvailability.freeMinutes())
+                 << " in " << weeklyAvailability.toSlots().size() << " merged blocks" << endl;
+            cout << "Free Hours Before Friday: " 
+                 << TimeSlot::formatHours(weeklyAvailability.freeMinutesBeforeDay(4)) << endl;
+        }
         
         if (courses.empty()) {
             cout << "No courses to analyze." << endl;
             return;
         }
         
-        int totalHours = 0, completedHours = 0, activeCourses = 0;
-        for (const auto& course : courses) {
-            totalHours += course->getTotalHours();
-            completedHours += course->getCompletedHours();
-            if (course->getPriority() > 0) activeCourses++;
-        }
-        
-        cout << "Active Courses: " << activeCourses << endl;
-        cout << "Total Study Hours Needed: " << totalHours << endl;
-        cout << "Hours Completed: " << completedHours << endl;
-        cout << "Remaining Hours: " << (totalHours - completedHours) << endl;
+        // A course has positive priority exactly when it is queued, so all
+        // figures come from maintained totals without scanning the courses
+        cout << "Active Courses: " << courseQueue.size() << endl;
+        cout << "Total Study Hours Needed: " << totalHoursNeeded << endl;
+        cout << "Hours Completed: " << totalHoursCompleted << endl;
+        cout << "Remaining Hours: " << (totalHoursNeeded - totalHoursCompleted) << endl;
         
-        if (totalHours > 0) {
-            double percentage = (double)completedHours / totalHours * 100;
+        if (totalHoursNeeded > 0) {
+            double percentage = (double)totalHoursCompleted / totalHoursNeeded * 100;
             cout << "Completion Percentage: " << fixed << setprecision(1) 
                  << percentage << "%" << endl;
         }
@@ -504,6 +5251,160 @@ public:
              << setfill('0') << setw(2) << (timeinfo->tm_mon + 1) << "-" 
              << setfill('0') << setw(2) << timeinfo->tm_mday << endl;
     }
+    
+    // Small instances with known answers, planned on private optimizers so
+    // the user's courses are untouched. Prints one PASS/FAIL line per check
+    // and returns whether all passed.
+    bool runSelfChecks() const {
+        cout << "\n=== SCHEDULER SELF-CHECKS ===" << endl;
+        bool allPassed = true;
+        auto report = [&](const string& check, bool passed) {
+            cout << (passed ? "PASS  " : "FAIL  ") << check << endl;
+            allPassed = allPassed && passed;
+        };
+        // Plans start on a Monday at least a week ahead, so no exam is past
+        int today = Calendar::today();
+        int monday = today + 7 + (7 - Calendar::weekday(today)) % 7;
+        auto date = [monday](int offset) { return Calendar::formatIsoDate(monday + offset); };
+        
+        // Mondays 09:00-12:00 only. A needs 4h before its exam on the second
+        // Tuesday, which leaves it two Mondays; B needs 4h and also has the
+        // third Monday. Both fit: 8h in total, all of A's 4h in time.
+        {
+            ScheduleOptimizer tiny;
+            tiny.setPlanningStart(date(0));
+            tiny.addCourse(make_shared<Course>("A", 2, date(8), 4));
+            tiny.addCourse(make_shared<Course>("B", 5, date(15), 4));
+            tiny.addTimeSlot(TimeSlot("Monday", "09:00", "12:00"));
+            PlanningSnapshot snapshot = tiny.takeSnapshot();
+            Schedule edf = tiny.runStrategy(EARLIEST_DEADLINE_FIRST, snapshot);
+            Schedule flow = tiny.runStrategy(MIN_COST_FLOW, snapshot);
+            report("Earliest deadline first books 8h (got " + 
+                   TimeSlot::formatHours((int)edf.getTotalStudyMinutes()) + "h)",
+                   edf.getTotalStudyMinutes() == 8 * 60);
+            report("Min-cost flow books as much as earliest deadline first (got " + 
+                   TimeSlot::formatHours((int)flow.getTotalStudyMinutes()) + "h)",
+                   flow.getTotalStudyMinutes() == edf.getTotalStudyMinutes());
+            report("Min-cost flow gives A all 4h before its exam",
+                   flow.getCourseMinutes(tiny.courses[0].get()) == 4 * 60);
+        }
+        
+        // More work than time, exams spread over five weeks: every mode must
+        // keep each session after the planning start and before its exam
+        {
+            ScheduleOptimizer busy;
+            busy.setPlanningStart(date(0));
+            for (int i = 0; i < 6; i++) {
+                busy.addCourse(make_shared<Course>("Course " + to_string(i + 1), 1 + i % 5, 
+                                                   date(3 + 6 * i), 8 + 3 * i));
+            }
+            busy.addTimeSlot(TimeSlot("Monday", "18:00", "21:00"));
+            busy.addTimeSlot(TimeSlot("Wednesday", "08:00", "10:30"));
+            busy.addTimeSlot(TimeSlot("Saturday", "10:00", "16:00"));
+            PlanningSnapshot snapshot = busy.takeSnapshot();
+            static const OptimizationStrategy modes[] = {
+                PRIORITY_BASED, TIME_BALANCED, DIFFICULTY_FIRST, 
+                EARLIEST_DEADLINE_FIRST, MIN_COST_FLOW, SPACED_REPETITION
+            };
+            for (OptimizationStrategy mode : modes) {
+                Schedule plan = busy.runStrategy(mode, snapshot);
+                bool inTime = true;
+                for (const auto& session : plan.getSessions()) {
+                    inTime = inTime && session.getDate() >= monday && 
+                             session.getDate() < plan.getCourse(session)->getExamDay();
+                }
+                report(strategyName(mode) + ": no session on or after an exam", inTime);
+            }
+        }
+        
+        // Far more courses than time, so the priority pass ranks only the
+        // reachable ones up front and the rest on demand. The plan must match
+        // the one made from a full ranking.
+        {
+            ScheduleOptimizer crowded;
+            crowded.setPlanningStart(date(0));
+            for (int i = 0; i < 240; i++) {
+                crowded.addCourse(make_shared<Course>("Course " + to_string(i + 1), 1 + i % 5,
+                                                      date(1 + (i * 7) % 40), 2 + i % 9));
+            }
+            crowded.addTimeSlot(TimeSlot("Tuesday", "19:00", "21:00"));
+            crowded.addTimeSlot(TimeSlot("Friday", "08:00", "09:30"));
+            PlanningSnapshot onDemand = crowded.takeSnapshot(true);
+            PlanningSnapshot full = crowded.takeSnapshot(false);
+            Schedule fromDemand = crowded.runStrategy(PRIORITY_BASED, onDemand);
+            Schedule fromFull = crowded.runStrategy(PRIORITY_BASED, full);
+            report("Ranking on demand (" + to_string(onDemand.rankedCount) + " of " + 
+                   to_string(onDemand.activeCourses.size()) + " ranked) matches a full ranking",
+                   onDemand.rankedCount < full.rankedCount && fromDemand.serialize() == fromFull.serialize());
+            
+            vector<size_t> all = crowded.courseQueue.orderedItems();
+            vector<size_t> top = crowded.courseQueue.orderedItems(25);
+            report("Top 25 of the course queue match its full order",
+                   top.size() == 25 && equal(top.begin(), top.end(), all.begin()));
+        }
+        
+        // A cohort competing for a few study rooms, planned on one thread and
+        // on four. Fair share must not depend on the thread count; first come
+        // may hand seats out differently but must never oversell a room.
+        {
+            vector<TimeSlot> rooms = {
+                TimeSlot("Monday", "09:00", "12:00"), TimeSlot("Wednesday", "14:00", "17:00"),
+                TimeSlot("Saturday", "10:00", "13:00")
+            };
+            const int roomCount[] = {2, 3, 1};
+            auto plan = [&](CohortScheduler::Mode mode, size_t workers) {
+                CohortScheduler cohort(monday);
+                cohort.setWorkerCount(workers);
+                for (size_t r = 0; r < rooms.size(); r++) cohort.addRoomSlot(rooms[r], roomCount[r]);
+                for (int i = 0; i < 24; i++) {
+                    CohortStudent student;
+                    student.name = "Student " + to_string(i + 1);
+                    for (int c = 0; c < 1 + i % 3; c++) {
+                        student.courses.push_back(make_shared<Course>("Course " + to_string(c + 1), 1 + (i + c) % 5,
+                                                                      date(10 + 7 * c + i % 4), 3 + (i + c) % 4));
+                    }
+                    if (i % 4 == 3) student.roomSlots = {1};
+                    cohort.addStudent(student);
+                }
+                return cohort.schedule(mode);
+            };
+            auto seatsKept = [&](const CohortResult& result) {
+                map<pair<int, size_t>, int> taken;     // (day, room slot) -> students
+                for (const auto& schedule : result.schedules) {
+                    set<pair<int, size_t>> used;
+                    for (const auto& session : schedule.getSessions()) {
+                        for (size_t r = 0; r < rooms.size(); r++) {
+                            if (rooms[r].overlaps(session.getTimeSlot())) used.insert({session.getDate(), r});
+                        }
+                    }
+                    for (const auto& key : used) taken[key]++;
+                }
+                for (const auto& entry : taken) {
+                    if (entry.second > roomCount[entry.first.second]) return false;
+                }
+                return result.seatsUsed <= result.seatsOffered && result.bookedMinutes <= result.demandMinutes;
+            };
+            
+            CohortResult fairOne = plan(CohortScheduler::FAIR_SHARE, 1);
+            CohortResult fairMany = plan(CohortScheduler::FAIR_SHARE, 4);
+            bool same = fairOne.schedules.size() == fairMany.schedules.size();
+            for (size_t i = 0; same && i < fairOne.schedules.size(); i++) {
+                same = fairOne.schedules[i].serialize() == fairMany.schedules[i].serialize();
+            }
+            report("Cohort fair share: same plan on 1 and 4 threads (" + 
+                   TimeSlot::formatHours((int)fairOne.bookedMinutes) + "h booked)", same);
+            report("Cohort fair share: no room oversold", seatsKept(fairOne) && seatsKept(fairMany));
+            
+            CohortResult firstOne = plan(CohortScheduler::FIRST_COME, 1);
+            CohortResult firstMany = plan(CohortScheduler::FIRST_COME, 4);
+            report("Cohort first come: no room oversold on 1 and 4 threads", 
+                   seatsKept(firstOne) && seatsKept(firstMany) && 
+                   firstOne.demandMinutes == firstMany.demandMinutes);
+        }
+        
+        cout << (allPassed ? "All checks passed." : "Some checks FAILED.") << endl;
+        return allPassed;
+    }
 };
 
 // ==================== USER INTERFACE CLASS ====================
@@ -523,8 +5424,15 @@ public:
         cout << "5. Generate Schedule" << endl;
         cout << "6. View Statistics" << endl;
         cout << "7. Load Sample Data" << endl;
-        cout << "8. Test Date Calculation" << endl;
-        cout << "9. Exit" << endl;
+        cout << "8. Run Self-Checks" << endl;
+        cout << "9. Log Study Hours" << endl;
+        cout << "10. Choose Scheduling Mode" << endl;
+        cout << "11. Move Exam / Remove Slot / Add Prerequisite" << endl;
+        cout << "12. Set Daily Limits" << endl;
+        cout << "13. Load Saved Schedule" << endl;
+        cout << "14. Import Courses (CSV)" << endl;
+        cout << "15. Find Group Study Times" << endl;
+        cout << "16. Exit" << endl;
         cout << string(50, '=') << endl;
         cout << "Enter your choice: ";
     }
@@ -557,10 +5465,13 @@ public:
             }
         } while (totalHours <= 0);
         
-        auto course = make_shared<Course>(name, difficulty, examDate, totalHours);
-        optimizer.addCourse(course);
-        
-        cout << "Course added successfully!" << endl;
+        try {
+            auto course = make_shared<Course>(name, difficulty, examDate, totalHours);
+            optimizer.addCourse(course);
+            cout << "Course added successfully!" << endl;
+        } catch (const invalid_argument& e) {
+            cout << "Course not added: " << e.what() << endl;
+        }
     }
     
     void addTimeSlot() {
@@ -586,13 +5497,289 @@ public:
             day.erase(day.find_last_not_of(" \t") + 1);
 
             if (!day.empty()) {
-                TimeSlot slot(day, startTime, endTime);
-                optimizer.addTimeSlot(slot);
-                cout << "Time slot for " << day << " added successfully!" << endl;
+                try {
+                    TimeSlot slot(day, startTime, endTime);
+                    if (optimizer.addTimeSlot(slot) > 0) {
+                        cout << "Merged with time you already added on " << slot.getDay() << "." << endl;
+                    } else {
+                        cout << "Time slot for " << slot.getDay() << " added successfully!" << endl;
+                    }
+                } catch (const invalid_argument& e) {
+                    cout << "Skipped: " << e.what() << endl;
+                }
+            }
+        }
+    }
+    
+    void logStudyHours() {
+        string name;
+        int hours;
+        
+        cout << "\n--- Log Study Hours ---" << endl;
+        cout << "Course Name: ";
+        cin.ignore();
+        getline(cin, name);
+        
+        cout << "Hours studied: ";
+        cin >> hours;
+        
+        ScheduleDiff diff;
+        if (optimizer.addStudyHours(name, hours, &diff)) {
+            cout << "Progress logged for " << name << "." << endl;
+            if (optimizer.isTrackingSchedule()) diff.display();
+        } else {
+            cout << "Could not log hours (unknown course, negative or too many hours)." << endl;
+        }
+        
+        auto next = optimizer.getNextCourse();
+        if (next) {
+            cout << "Study next: " << next->getName() << " (priority " 
+                 << fixed << setprecision(2) << next->getPriority() << ")" << endl;
+        } else {
+            cout << "All courses are complete!" << endl;
+        }
+    }
+    
+    void updateCourseOrSlot() {
+        int choice;
+        ScheduleDiff diff;
+        
+        cout << "\n--- Update ---" << endl;
+        cout << "1. Move an exam date" << endl;
+        cout << "2. Remove a time slot" << endl;
+        cout << "3. Study one course before another" << endl;
+        cout << "Choice: ";
+        cin >> choice;
+        
+        if (choice == 1) {
+            string name, examDate;
+            cout << "Course Name: ";
+            cin.ignore();
+            getline(cin, name);
+            cout << "New Exam Date (YYYY-MM-DD): ";
+            cin >> examDate;
+            try {
+                if (!optimizer.moveExam(name, examDate, &diff)) {
+                    cout << "Unknown course." << endl;
+                    return;
+                }
+            } catch (const invalid_argument& e) {
+                cout << "Exam not moved: " << e.what() << endl;
+                return;
+            }
+            cout << "Exam date updated." << endl;
+        } else if (choice == 2) {
+            optimizer.displayTimeSlots();
+            size_t number;
+            cout << "Slot number to remove (1 = first listed): ";
+            cin >> number;
+            if (number == 0 || !optimizer.removeTimeSlot(number - 1, &diff)) {
+                cout << "No such slot." << endl;
+                return;
+            }
+            cout << "Time slot removed." << endl;
+        } else if (choice == 3) {
+            string before, after;
+            cout << "Study this course first: ";
+            cin.ignore();
+            getline(cin, before);
+            cout << "...before this course: ";
+            getline(cin, after);
+            try {
+                if (!optimizer.addPrerequisite(before, after)) {
+                    cout << "Unknown course." << endl;
+                    return;
+                }
+            } catch (const invalid_argument& e) {
+                cout << "Not added: " << e.what() << endl;
+                return;
+            }
+            cout << before << " will be scheduled before " << after 
+                 << " (priority-based and difficulty-first modes)." << endl;
+            return;
+        } else {
+            cout << "Invalid choice." << endl;
+            return;
+        }
+        
+        if (optimizer.isTrackingSchedule()) diff.display();
+    }
+    
+    void chooseSchedulingMode() {
+        int mode;
+        
+        cout << "\n--- Scheduling Mode ---" << endl;
+        cout << "1. Priority-based (most urgent course first)" << endl;
+        cout << "2. Earliest deadline first (never past an exam)" << endl;
+        cout << "3. Optimal (min-cost flow solver)" << endl;
+        cout << "4. Time-balanced (courses take turns)" << endl;
+        cout << "5. Difficulty-first (hardest course first)" << endl;
+        cout << "6. Best of all (compare every mode in parallel)" << endl;
+        cout << "7. Rolling window (book the next few days only)" << endl;
+        cout << "8. Spaced repetition (growing gaps up to each exam)" << endl;
+        cout << "9. Trade-offs (choose among plans balancing coverage, balance and earliness)" << endl;
+        cout << "Mode: ";
+        cin >> mode;
+        
+        switch (mode) {
+            case 1:
+                optimizer.setStrategy(ScheduleOptimizer::PRIORITY_BASED);
+                break;
+            case 2:
+                optimizer.setStrategy(ScheduleOptimizer::EARLIEST_DEADLINE_FIRST);
+                break;
+            case 3:
+                optimizer.setStrategy(ScheduleOptimizer::MIN_COST_FLOW);
+                break;
+            case 4:
+                optimizer.setStrategy(ScheduleOptimizer::TIME_BALANCED);
+                break;
+            case 5:
+                optimizer.setStrategy(ScheduleOptimizer::DIFFICULTY_FIRST);
+                break;
+            case 6:
+                optimizer.setStrategy(ScheduleOptimizer::BEST_OF_ALL);
+                break;
+            case 7: {
+                int days;
+                cout << "Days to book ahead (e.g. 7): ";
+                cin >> days;
+                optimizer.setRollingWindow(days);
+                optimizer.setStrategy(ScheduleOptimizer::ROLLING_WINDOW);
+                break;
+            }
+            case 8:
+                optimizer.setStrategy(ScheduleOptimizer::SPACED_REPETITION);
+                break;
+            case 9:
+                optimizer.setStrategy(ScheduleOptimizer::PARETO_FRONTIER);
+                break;
+            default:
+                cout << "Unknown mode, keeping the current one." << endl;
+                return;
+        }
+        cout << "Scheduling mode updated." << endl;
+    }
+    
+    Schedule chooseParetoPlan(const Schedule& shown) {
+        size_t plans = optimizer.getParetoFrontier().size();
+        int plan;
+        cout << "Pick a plan (1-" << plans << ", 0 keeps the one shown): ";
+        cin >> plan;
+        if (plan < 1 || plan > (int)plans) return shown;
+        return optimizer.paretoSchedule(plan - 1);
+    }
+    
+    void simulateRisk(const Schedule& schedule) {
+        RiskOptions options;
+        double missPercent;
+        
+        cout << "Chance of missing a session (%): ";
+        cin >> missPercent;
+        cout << "Random seed (same seed, same result): ";
+        cin >> options.seed;
+        options.missProbability = min(1.0, max(0.0, missPercent / 100));
+        optimizer.simulateCompletionRisk(schedule, options).display();
+    }
+    
+    // Reload the schedule saved by option 5 and keep it up to date from now on
+    void loadSavedSchedule() {
+        Schedule schedule("Optimized Study Schedule");
+        try {
+            if (!optimizer.loadSchedule("study_schedule.txt", schedule)) {
+                cout << "No saved schedule found (study_schedule.txt)." << endl;
+                return;
+            }
+        } catch (const invalid_argument& e) {
+            cout << "Schedule not loaded: " << e.what() << endl;
+            return;
+        }
+        schedule.displaySchedule();
+        optimizer.trackSchedule(schedule);
+    }
+    
+    void importCourses() {
+        string filename;
+        cout << "\n--- Import Courses ---" << endl;
+        cout << "One course per line: name,difficulty,exam date,total hours,hours completed" << endl;
+        cout << "CSV file: ";
+        cin.ignore();
+        getline(cin, filename);
+        
+        ImportReport report;
+        if (!optimizer.importCourses(filename, report)) {
+            cout << "Could not open " << filename << endl;
+            return;
+        }
+        report.display();
+    }
+    
+    // Common free time of this student (their time slots) and classmates
+    // whose free times are typed in here
+    void findGroupStudyTimes() {
+        int students, minMinutes;
+        cout << "\n--- Group Study Times ---" << endl;
+        cout << "How many other students? ";
+        cin >> students;
+        cin.ignore();
+        
+        vector<vector<TimeSlot>> others;
+        for (int i = 0; i < students; i++) {
+            cout << "Free times of student " << (i + 1) 
+                 << ", one per line as 'Day HH:MM-HH:MM' (empty line to finish):" << endl;
+            vector<TimeSlot> slots;
+            string line;
+            while (getline(cin, line) && !line.empty()) {
+                stringstream ss(line);
+                string day, range;
+                ss >> day >> range;
+                size_t dash = range.find('-');
+                try {
+                    if (dash == string::npos) throw invalid_argument("expected Day HH:MM-HH:MM");
+                    slots.emplace_back(day, range.substr(0, dash), range.substr(dash + 1));
+                } catch (const invalid_argument& e) {
+                    cout << "Skipped '" << line << "': " << e.what() << endl;
+                }
             }
+            others.push_back(slots);
+        }
+        
+        cout << "Shortest useful session (minutes): ";
+        cin >> minMinutes;
+        
+        vector<TimeSlot> windows = optimizer.findGroupStudyTimes(others, minMinutes);
+        if (windows.empty()) {
+            cout << "No time when everyone is free for " << minMinutes << " minutes." << endl;
+            return;
+        }
+        cout << "Everyone is free:" << endl;
+        for (const auto& window : windows) {
+            cout << "  " << window.getDay() << " " << window.getStartTime() << "-" << window.getEndTime()
+                 << " (" << TimeSlot::formatHours(window.getDurationMinutes()) << "h)" << endl;
         }
     }
     
+    void setDailyLimits() {
+        double dayHours, courseHours;
+        int breakMinutes;
+        
+        cout << "\n--- Daily Limits (0 = no limit) ---" << endl;
+        optimizer.getStudyLimits().display();
+        cout << "Max study hours per day: ";
+        cin >> dayHours;
+        cout << "Max hours per course per day: ";
+        cin >> courseHours;
+        cout << "Minimum break between sessions (minutes): ";
+        cin >> breakMinutes;
+        
+        StudyLimits limits;
+        limits.maxMinutesPerDay = max(0, (int)llround(dayHours * 60));
+        limits.maxCourseMinutesPerDay = max(0, (int)llround(courseHours * 60));
+        limits.minBreakMinutes = max(0, breakMinutes);
+        optimizer.setStudyLimits(limits);
+        limits.display();
+    }
+    
     void loadSampleData() {
         cout << "\nLoading sample data..." << endl;
         
@@ -625,6 +5812,7 @@ public:
         optimizer.addCourse(make_shared<Course>("Algorithm Analysis", 5, examDates[1], 30));
         optimizer.addCourse(make_shared<Course>("Database Systems", 3, examDates[2], 20));
         optimizer.addCourse(make_shared<Course>("Software Engineering", 3, examDates[3], 22));
+        optimizer.addPrerequisite("Data Structures", "Algorithm Analysis");
         
         // Sample time slots
         optimizer.addTimeSlot(TimeSlot("Monday", "09:00", "12:00"));
@@ -670,8 +5858,30 @@ public:
                     break;
                 case 5: {
                     Schedule schedule = optimizer.generateSchedule();
+                    if (optimizer.getStrategy() == ScheduleOptimizer::PARETO_FRONTIER &&
+                        optimizer.getParetoFrontier().size() > 1) {
+                        schedule = chooseParetoPlan(schedule);
+                    }
                     schedule.displaySchedule();
                     
+                    cout << "\nImprove the schedule with local search? (y/n): ";
+                    char improve;
+                    cin >> improve;
+                    if ((improve == 'y' || improve == 'Y') && !schedule.getSessions().empty()) {
+                        schedule = optimizer.improveSchedule(schedule);
+                        schedule.displaySchedule();
+                    }
+                    // Later progress and changes update this schedule in place
+                    // (except rolling-window plans, which replan on the next run)
+                    optimizer.trackSchedule(schedule);
+                    
+                    cout << "\nSimulate missed sessions to check completion risk? (y/n): ";
+                    char simulate;
+                    cin >> simulate;
+                    if ((simulate == 'y' || simulate == 'Y') && !schedule.getSessions().empty()) {
+                        simulateRisk(schedule);
+                    }
+                    
                     cout << "\nSave schedule to file? (y/n): ";
                     char save;
                     cin >> save;
@@ -688,8 +5898,30 @@ public:
                     break;
                 case 8:
                     optimizer.testDateCalculation();
+                    optimizer.runSelfChecks();
                     break;
                 case 9:
+                    logStudyHours();
+                    break;
+                case 10:
+                    chooseSchedulingMode();
+                    break;
+                case 11:
+                    updateCourseOrSlot();
+                    break;
+                case 12:
+                    setDailyLimits();
+                    break;
+                case 13:
+                    loadSavedSchedule();
+                    break;
+                case 14:
+                    importCourses();
+                    break;
+                case 15:
+                    findGroupStudyTimes();
+                    break;
+                case 16:
                     cout << "Thank you for using Study Schedule Optimizer!" << endl;
                     return;
                 default: